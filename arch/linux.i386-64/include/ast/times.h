@@ -0,0 +1,44 @@
+/***********************************************************************
+*                                                                      *
+*               This software is part of the ast package               *
+*          Copyright (c) 1985-2011 AT&T Intellectual Property          *
+*          Copyright (c) 2020-2022 Contributors to ksh 93u+m           *
+*                      and is licensed under the                       *
+*                 Eclipse Public License, Version 2.0                  *
+*                                                                      *
+*                A copy of the License is available at                 *
+*      https://www.eclipse.org/org/documents/epl-2.0/EPL-2.0.html      *
+*         (with md5 checksum 84283fa8859daf213bdda5a9f8d1be1d)         *
+*                                                                      *
+*                 Glenn Fowler <gsf@research.att.com>                  *
+*                  David Korn <dgk@research.att.com>                   *
+*                   Phong Vo <kpv@research.att.com>                    *
+*                  Martijn Dekker <martijn@inlv.org>                   *
+*                                                                      *
+***********************************************************************/
+/*
+ * Glenn Fowler
+ * AT&T Research
+ *
+ * -last clock_t,time_t interface definitions plus
+ *
+ *	<ast.h>
+ *	<time.h>
+ *	<sys/time.h>
+ *	<sys/times.h>
+ */
+
+#ifndef _TIMES_H
+#define _TIMES_H
+
+#include <ast.h>
+
+#undef	_TIMES_H
+#include <ast_time.h>
+#ifndef _TIMES_H
+#define _TIMES_H
+#endif
+
+extern int		touch(const char*, time_t, time_t, int);
+
+#endif
@@ -0,0 +1,10 @@
+/* : : generated from src/lib/libast/features/sizeof by iffe version 2024-12-23 : : */
+#ifndef _def_sizeof_ast
+#define _def_sizeof_ast	1
+#define _sys_types	1	/* #include <sys/types.h> ok */
+#define _ast_sizeof_char	1
+#define _ast_sizeof_short	2
+#define _ast_sizeof_int		4
+#define _ast_sizeof_long	8
+#define _ast_sizeof_intmax_t	8
+#endif
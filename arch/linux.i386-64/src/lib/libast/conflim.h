@@ -0,0 +1,198 @@
+/* : : generated by conf from /root/repo/src/lib/libast/comp/conf.tab : : */
+
+/*
+ * supplemental <limits.h> values
+ */
+
+printf("#ifndef AIO_MAX\n");
+printf("#define AIO_MAX 1\n");
+printf("#endif\n");
+printf("#ifndef AIO_PRIO_DELTA_MAX\n");
+printf("#define AIO_PRIO_DELTA_MAX 20\n");
+printf("#endif\n");
+printf("#ifndef ARG_MAX\n");
+printf("#define ARG_MAX 2097152\n");
+printf("#endif\n");
+printf("#ifndef ATEXIT_MAX\n");
+printf("#define ATEXIT_MAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef CHARCLASS_NAME_MAX\n");
+printf("#define CHARCLASS_NAME_MAX 2048\n");
+printf("#endif\n");
+printf("#ifndef CHAR_BIT\n");
+printf("#define CHAR_BIT 8\n");
+printf("#endif\n");
+printf("#ifndef CHAR_MAX\n");
+printf("#define CHAR_MAX 127\n");
+printf("#endif\n");
+printf("#ifndef CHAR_MIN\n");
+printf("#define CHAR_MIN -128\n");
+printf("#endif\n");
+printf("#ifndef CHILD_MAX\n");
+printf("#define CHILD_MAX 24001\n");
+printf("#endif\n");
+printf("#ifndef CLK_TCK\n");
+printf("#define CLK_TCK 100\n");
+printf("#endif\n");
+printf("#ifndef FCHR_MAX\n");
+printf("#define FCHR_MAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef FILESIZEBITS\n");
+printf("#define FILESIZEBITS 32\n");
+printf("#endif\n");
+printf("#ifndef INT_MAX\n");
+printf("#define INT_MAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef INT_MIN\n");
+printf("#define INT_MIN -2147483648\n");
+printf("#endif\n");
+printf("#ifndef LLONG_MAX\n");
+printf("#define LLONG_MAX 9223372036854775807\n");
+printf("#endif\n");
+printf("#ifndef LLONG_MIN\n");
+printf("#define LLONG_MIN -9223372036854775808\n");
+printf("#endif\n");
+printf("#ifndef LOGIN_NAME_MAX\n");
+printf("#define LOGIN_NAME_MAX 256\n");
+printf("#endif\n");
+printf("#ifndef LONG_BIT\n");
+printf("#define LONG_BIT 64\n");
+printf("#endif\n");
+printf("#ifndef LONG_MAX\n");
+printf("#define LONG_MAX 9223372036854775807\n");
+printf("#endif\n");
+printf("#ifndef LONG_MIN\n");
+printf("#define LONG_MIN -9223372036854775808\n");
+printf("#endif\n");
+printf("#ifndef MB_LEN_MAX\n");
+printf("#define MB_LEN_MAX 16\n");
+printf("#endif\n");
+printf("#ifndef NL_ARGMAX\n");
+printf("#define NL_ARGMAX 4096\n");
+printf("#endif\n");
+printf("#ifndef NL_LANGMAX\n");
+printf("#define NL_LANGMAX 2048\n");
+printf("#endif\n");
+printf("#ifndef NL_MSGMAX\n");
+printf("#define NL_MSGMAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef NL_NMAX\n");
+printf("#define NL_NMAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef NL_SETMAX\n");
+printf("#define NL_SETMAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef NL_TEXTMAX\n");
+printf("#define NL_TEXTMAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef NSS_BUFLEN_GROUP\n");
+printf("#define NSS_BUFLEN_GROUP 1024\n");
+printf("#endif\n");
+printf("#ifndef NSS_BUFLEN_PASSWD\n");
+printf("#define NSS_BUFLEN_PASSWD 1024\n");
+printf("#endif\n");
+printf("#ifndef NZERO\n");
+printf("#define NZERO 20\n");
+printf("#endif\n");
+printf("#ifndef OPEN_MAX\n");
+printf("#define OPEN_MAX 20000\n");
+printf("#endif\n");
+printf("#ifndef PASS_MAX\n");
+printf("#define PASS_MAX 8192\n");
+printf("#endif\n");
+printf("#ifndef PATH_MAX\n");
+printf("#define PATH_MAX 4096\n");
+printf("#endif\n");
+printf("#ifndef PID_MAX\n");
+printf("#define PID_MAX 32768\n");
+printf("#endif\n");
+printf("#ifndef PTHREAD_DESTRUCTOR_ITERATIONS\n");
+printf("#define PTHREAD_DESTRUCTOR_ITERATIONS 4\n");
+printf("#endif\n");
+printf("#ifndef PTHREAD_KEYS_MAX\n");
+printf("#define PTHREAD_KEYS_MAX 1024\n");
+printf("#endif\n");
+printf("#ifndef PTRDIFF_MAX\n");
+printf("#define PTRDIFF_MAX 9223372036854775807\n");
+printf("#endif\n");
+printf("#ifndef PTRDIFF_MIN\n");
+printf("#define PTRDIFF_MIN -9223372036854775808\n");
+printf("#endif\n");
+printf("#ifndef RE_DUP_MAX\n");
+printf("#define RE_DUP_MAX 32767\n");
+printf("#endif\n");
+printf("#ifndef SCHAR_MAX\n");
+printf("#define SCHAR_MAX 127\n");
+printf("#endif\n");
+printf("#ifndef SCHAR_MIN\n");
+printf("#define SCHAR_MIN -128\n");
+printf("#endif\n");
+printf("#ifndef SHRT_MAX\n");
+printf("#define SHRT_MAX 32767\n");
+printf("#endif\n");
+printf("#ifndef SHRT_MIN\n");
+printf("#define SHRT_MIN -32768\n");
+printf("#endif\n");
+printf("#ifndef SIG_ATOMIC_MAX\n");
+printf("#define SIG_ATOMIC_MAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef SIG_ATOMIC_MIN\n");
+printf("#define SIG_ATOMIC_MIN -2147483648\n");
+printf("#endif\n");
+printf("#ifndef SIZE_MAX\n");
+printf("#define SIZE_MAX 18446744073709551615\n");
+printf("#endif\n");
+printf("#ifndef SSIZE_MAX\n");
+printf("#define SSIZE_MAX 32767\n");
+printf("#endif\n");
+printf("#ifndef STD_BLK\n");
+printf("#define STD_BLK 1024\n");
+printf("#endif\n");
+printf("#ifndef SYSPID_MAX\n");
+printf("#define SYSPID_MAX 2\n");
+printf("#endif\n");
+printf("#ifndef THREAD_DESTRUCTOR_ITERATIONS\n");
+printf("#define THREAD_DESTRUCTOR_ITERATIONS 4\n");
+printf("#endif\n");
+printf("#ifndef THREAD_KEYS_MAX\n");
+printf("#define THREAD_KEYS_MAX 128\n");
+printf("#endif\n");
+printf("#ifndef THREAD_THREADS_MAX\n");
+printf("#define THREAD_THREADS_MAX 64\n");
+printf("#endif\n");
+printf("#ifndef TMP_MAX\n");
+printf("#define TMP_MAX 238328\n");
+printf("#endif\n");
+printf("#ifndef UCHAR_MAX\n");
+printf("#define UCHAR_MAX 255\n");
+printf("#endif\n");
+printf("#ifndef UID_MAX\n");
+printf("#define UID_MAX 60002\n");
+printf("#endif\n");
+printf("#ifndef UINT_MAX\n");
+printf("#define UINT_MAX 4294967295\n");
+printf("#endif\n");
+printf("#ifndef ULLONG_MAX\n");
+printf("#define ULLONG_MAX 18446744073709551615\n");
+printf("#endif\n");
+printf("#ifndef ULONG_MAX\n");
+printf("#define ULONG_MAX 18446744073709551615\n");
+printf("#endif\n");
+printf("#ifndef USHRT_MAX\n");
+printf("#define USHRT_MAX 65535\n");
+printf("#endif\n");
+printf("#ifndef WCHAR_MAX\n");
+printf("#define WCHAR_MAX 2147483647\n");
+printf("#endif\n");
+printf("#ifndef WCHAR_MIN\n");
+printf("#define WCHAR_MIN -2147483648\n");
+printf("#endif\n");
+printf("#ifndef WINT_MAX\n");
+printf("#define WINT_MAX 4294967295\n");
+printf("#endif\n");
+printf("#ifndef WINT_MIN\n");
+printf("#define WINT_MIN 0\n");
+printf("#endif\n");
+printf("#ifndef WORD_BIT\n");
+printf("#define WORD_BIT 32\n");
+printf("#endif\n");
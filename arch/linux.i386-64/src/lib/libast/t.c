@@ -0,0 +1 @@
+#include "FEATURE/standards"
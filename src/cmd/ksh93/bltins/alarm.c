@@ -48,6 +48,8 @@ struct	tevent
 	Namval_t	*node;
 	Namval_t	*action;
 	struct tevent	*next;
+	struct tevent	*prev;
+	struct tevent	*fired;		/* next in queue of alarms to run */
 	long		milli;
 	int		flags;
 	void            *timeout;
@@ -55,110 +57,183 @@ struct	tevent
 
 static const char ALARM[] = "alarm";
 
+static struct tevent	*firsttrap, *lasttrap;
+
 static void	trap_timeout(void*);
 
 /*
- * insert timeout item on current given list in sorted order
+ * the alarm list is a ring of timeout items around a sentinel that is
+ * allocated on first use, so that deleting items never changes the
+ * list pointer in sh.st, which is saved and restored by function calls
  */
-static void *time_add(struct tevent *item, void *list)
+static struct tevent *time_list(void)
 {
-	struct tevent *tp = (struct tevent*)list;
-	if(!tp || item->milli < tp->milli)
-	{
-		item->next = tp;
-		list = item;
-	}
-	else
+	struct tevent *list = (struct tevent*)sh.st.timetrap;
+	if(!list)
 	{
-		while(tp->next && item->milli > tp->next->milli)
-			tp = tp->next;
-		item->next = tp->next;
-		tp->next = item;
+		list = sh_newof(NULL,struct tevent,1,0);
+		list->next = list->prev = list;
+		sh.st.timetrap = list;
 	}
-	tp = item;
-	tp->timeout = sh_timeradd(tp->milli,tp->flags&R_FLAG,trap_timeout,tp);
 	return list;
 }
 
 /*
- * delete timeout item from current given list, delete timer
+ * append timeout item to the alarm list and start its timer
  */
-static 	void *time_delete(struct tevent *item, void *list)
+static void time_add(struct tevent *item)
 {
-	struct tevent *tp = (struct tevent*)list;
-	if(item==tp)
-		list = tp->next;
-	else
+	struct tevent *list = time_list();
+	item->next = list;
+	item->prev = list->prev;
+	list->prev->next = item;
+	list->prev = item;
+	item->timeout = sh_timeradd(item->milli,item->flags&R_FLAG,trap_timeout,item);
+}
+
+/*
+ * delete timeout item from the alarm list, delete timer
+ */
+static void time_delete(struct tevent *item)
+{
+	if(item->next)
 	{
-		while(tp && tp->next != item)
-			tp = tp->next;
-		if(tp)
-			tp->next = item->next;
+		item->prev->next = item->next;
+		item->next->prev = item->prev;
+		item->next = item->prev = 0;
 	}
 	if(item->timeout)
 		sh_timerdel(item->timeout);
-	return list;
 }
 
-static void	print_alarms(void *list)
+/*
+ * remove timeout item from the queue of alarms to run
+ */
+static void time_unqueue(struct tevent *item)
 {
-	struct tevent *tp = (struct tevent*)list;
-	while(tp)
+	struct tevent *tp, *tplast=0;
+	if(!(item->flags&L_FLAG))
+		return;
+	sigblock(SIGALRM);
+	for(tp=firsttrap; tp && tp!=item; tp=tp->fired)
+		tplast = tp;
+	if(tp)
 	{
+		if(tplast)
+			tplast->fired = tp->fired;
+		else
+			firsttrap = tp->fired;
+		if(lasttrap==tp)
+			lasttrap = tplast;
+	}
+	item->flags &= ~L_FLAG;
+	sigrelease(SIGALRM);
+}
+
+static int	alarmcmp(const void *a, const void *b)
+{
+	long x = (*(struct tevent**)a)->milli, y = (*(struct tevent**)b)->milli;
+	return x<y ? -1 : x>y;
+}
+
+/*
+ * list the pending alarms in order of their delay
+ */
+static void	print_alarms(void *list)
+{
+	struct tevent *tp, **vec;
+	size_t n = 0;
+	if(!list)
+		return;
+	for(tp=((struct tevent*)list)->next; tp!=list; tp=tp->next)
+		if(tp->timeout)
+			n++;
+	if(n==0)
+		return;
+	vec = (struct tevent**)sh_malloc((n+1)*sizeof(struct tevent*));
+	for(n=0,tp=((struct tevent*)list)->next; tp!=list; tp=tp->next)
 		if(tp->timeout)
+			vec[n++] = tp;
+	vec[n] = 0;
+	qsort(vec,n,sizeof(struct tevent*),alarmcmp);
+	for(n=0; tp=vec[n]; n++)
+	{
+		char *name = nv_name(tp->node);
+		if(tp->flags&R_FLAG)
 		{
-			char *name = nv_name(tp->node);
-			if(tp->flags&R_FLAG)
-			{
-				double d = tp->milli;
-				sfprintf(sfstdout,e_alrm1,name,d/1000.);
-			}
-			else
-				sfprintf(sfstdout,e_alrm2,name,nv_getnum(tp->node));
+			double d = tp->milli;
+			sfprintf(sfstdout,e_alrm1,name,d/1000.);
 		}
-		tp = tp->next;
+		else
+			sfprintf(sfstdout,e_alrm2,name,nv_getnum(tp->node));
 	}
+	free(vec);
 }
 
+/*
+ * called from the SIGALRM handler; queue the alarm to be run by sh_timetraps()
+ */
 static void	trap_timeout(void* handle)
 {
 	struct tevent *tp = (struct tevent*)handle;
 	sh.trapnote |= SH_SIGALRM;
 	if(!(tp->flags&R_FLAG))
 		tp->timeout = 0;
-	tp->flags |= L_FLAG;
+	if(!(tp->flags&L_FLAG))
+	{
+		tp->flags |= L_FLAG;
+		tp->fired = 0;
+		if(lasttrap)
+			lasttrap->fired = tp;
+		else
+			firsttrap = tp;
+		lasttrap = tp;
+	}
 	sh.sigflag[SIGALRM] |= SH_SIGALRM;
 	if(sh_isstate(SH_TTYWAIT))
 		sh_timetraps();
 }
 
+/*
+ * take the next alarm off the queue; SIGALRM is blocked so
+ * that trap_timeout() cannot append to the queue meanwhile
+ */
+static struct tevent *time_next(void)
+{
+	struct tevent *tp;
+	sigblock(SIGALRM);
+	if(tp=firsttrap)
+	{
+		if(!(firsttrap = tp->fired))
+			lasttrap = 0;
+		tp->flags &= ~L_FLAG;
+	}
+	sigrelease(SIGALRM);
+	return tp;
+}
+
+/*
+ * run the actions for the alarms that went off, in the order they did;
+ * an action may itself run alarms or delete them from the queue
+ */
 void	sh_timetraps(void)
 {
-	struct tevent *tp, *tpnext;
-	struct tevent *tptop;
+	struct tevent *tp;
 	while(1)
 	{
 		sh.sigflag[SIGALRM] &= ~SH_SIGALRM;
-		tptop= (struct tevent*)sh.st.timetrap;
-		for(tp=tptop;tp;tp=tpnext)
+		while(tp=time_next())
 		{
-			tpnext = tp->next;
-			if(tp->flags&L_FLAG)
-			{
-				tp->flags &= ~L_FLAG;
-				if(tp->action)
-					sh_fun(tp->action,tp->node,NULL);
-				tp->flags &= ~L_FLAG;
-				if(!tp->flags)
-					nv_unset(tp->node);
-			}
+			if(tp->action)
+				sh_fun(tp->action,tp->node,NULL);
+			if(!tp->flags)
+				nv_unset(tp->node);
 		}
 		if(!(sh.sigflag[SIGALRM]&SH_SIGALRM))
 			break;
 	}
 }
 
-
 /*
  * This trap function catches "alarm" actions only
  */
@@ -202,15 +277,15 @@ static void putval(Namval_t* np, const char* val, int flag, Namfun_t* fp)
 		else
 			d -= now;
 		tp->milli = 1000*(d+.0005);
-		if(tp->timeout)
-			sh.st.timetrap = time_delete(tp,sh.st.timetrap);
+		time_delete(tp);
 		if(tp->milli > 0)
-			sh.st.timetrap = time_add(tp,sh.st.timetrap);
+			time_add(tp);
 	}
 	else
 	{
 		tp = (struct tevent*)nv_stack(np, NULL);
-		sh.st.timetrap = time_delete(tp,sh.st.timetrap);
+		time_delete(tp);
+		time_unqueue(tp);
 		nv_unset(np);
 		free(fp);
 	}
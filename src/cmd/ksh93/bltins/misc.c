@@ -291,10 +291,11 @@ int    b_dot_cmd(int n,char *argv[],Shbltin_t *context)
 				UNREACHABLE();
 			}
 			filename = path_fullname(stkptr(sh.stk,PATH_OFFSET));
+			sh_tcacheopen(fd,filename);
 		}
 	}
 	*prevscope = sh.st;
-	sh.st.lineno = np?((struct functnod*)nv_funtree(np))->functline:1;
+	sh.st.lineno = np?((struct functnod*)sh_tlazy((Shnode_t*)nv_funtree(np)))->functline:1;
 	sh.st.save_tree = sh.var_tree;
 	if(filename)
 	{
@@ -321,11 +322,12 @@ int    b_dot_cmd(int n,char *argv[],Shbltin_t *context)
 		sh.dot_depth++;
 		update_sh_level();
 		if(np)
-			sh_exec((Shnode_t*)(nv_funtree(np)),sh_isstate(SH_ERREXIT));
+			sh_exec(sh_tlazy((Shnode_t*)nv_funtree(np)),sh_isstate(SH_ERREXIT));
 		else
 		{
 			buffer = sh_malloc(IOBSIZE+1);
 			iop = sfnew(NULL,buffer,IOBSIZE,fd,SFIO_READ);
+			path_prefetch(iop);
 			sh_offstate(SH_NOFORK);
 			sh_eval(iop,sh_isstate(SH_PROFILE)?SH_FUNEVAL:0);
 		}
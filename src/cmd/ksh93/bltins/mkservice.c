@@ -93,6 +93,10 @@ static const char eloop_usage[] =
 #include	<nval.h>
 #include	<sys/socket.h>
 #include 	<netinet/in.h>
+#include	"FEATURE/poll"
+#if _sys_epoll
+#   include	<sys/epoll.h>
+#endif
 
 #define ACCEPT	0
 #define ACTION	1
@@ -125,31 +129,129 @@ struct Service_s
 	Namval_t*	disc[elementsof(disctab)-1];
 };
 
+/*
+ * Each watched file descriptor is mapped to its service by service_list[fd].
+ * While the action function of a connection runs, inaction[fd] is set and
+ * the descriptor is not waited on; unwatch() clears it if the action closes
+ * or moves the connection, so process_fd() knows not to touch it afterwards.
+ * Where epoll(7) is available, the kernel keeps the set of descriptors to
+ * watch, so registering, removing and waiting on a descriptor does not
+ * depend on the number of connections. Otherwise, the descriptors are kept
+ * in file_list (with file_index[fd] giving their position) and sfpoll() is
+ * used. Either way, data already buffered by sfio is noticed: connections
+ * that have buffered input left after their action are queued on pending.
+ */
+static Service_t	**service_list;
+static char		*inaction;
+static int		nservice;
+static int		*pending;
+static int		npending;
+static int		(*covered_fdnotify)(int, int);
+#if _sys_epoll && _lib_epoll_create1
+#   define SERVICE_EPOLL	1
+#   define MAXEVENTS	64
+static int		epfd = -1;
+static struct epoll_event events[MAXEVENTS];
+#else
 static int		*file_list;
+static int		*file_index;
 static Sfio_t		**poll_list;
-static Service_t	**service_list;
+static Sfio_t		**ready_list;
+#endif
 static int		npoll;
 static int		nready;
 static int		ready;
-static int		(*covered_fdnotify)(int, int);
 
-static int fdclose(Service_t *sp, int fd)
+/*
+ * make sure the tables can hold file descriptor fd
+ */
+static void service_grow(int fd)
 {
-	int i;
+	int n = nservice;
+	if(fd < n)
+		return;
+	while(n <= fd)
+		n = n ? 2*n : 64;
+	service_list = sh_newof(service_list,Service_t*,n,nservice);
+	inaction = sh_newof(inaction,char,n,nservice);
+	pending = sh_newof(pending,int,n,nservice);
+#if !SERVICE_EPOLL
+	file_list = sh_newof(file_list,int,n,nservice);
+	file_index = sh_newof(file_index,int,n,nservice);
+	poll_list = sh_newof(poll_list,Sfio_t*,n+1,nservice?nservice+1:0);
+	ready_list = sh_newof(ready_list,Sfio_t*,n+1,nservice?nservice+1:0);
+#endif
+	nservice = n;
+}
+
+/*
+ * start watching fd for input on behalf of service sp
+ */
+static void watch(Service_t *sp, int fd)
+{
+	service_grow(fd);
+	if(!service_list[fd])
+	{
+#if SERVICE_EPOLL
+		struct epoll_event ev;
+		ev.events = EPOLLIN;
+		ev.data.fd = fd;
+		epoll_ctl(epfd,EPOLL_CTL_ADD,fd,&ev);
+#else
+		file_index[fd] = npoll;
+		file_list[npoll] = fd;
+#endif
+		npoll++;
+	}
+	service_list[fd] = sp;
+}
+
+/*
+ * stop watching fd; must be called while fd is still open
+ */
+static int unwatch(int fd)
+{
+	if(fd<0 || fd>=nservice || !service_list[fd])
+		return 0;
 	service_list[fd] = 0;
-	if(sp->fd==fd)
-		sp->fd = -1;
-	for(i=0; i < npoll; i++)
+	inaction[fd] = 0;
+#if SERVICE_EPOLL
+	epoll_ctl(epfd,EPOLL_CTL_DEL,fd,NULL);
+	npoll--;
+#else
 	{
-		if(file_list[i]==fd)
-		{
-			file_list[i] = file_list[npoll--];
-			if(sp->actionf)
-				(*sp->actionf)(sp, fd, 1);
-			return 1;
-		}
+		int i = file_index[fd];
+		file_list[i] = file_list[--npoll];
+		file_index[file_list[i]] = i;
 	}
-	return 0;
+#endif
+	return 1;
+}
+
+#if SERVICE_EPOLL
+/*
+ * stop or resume waiting on a watched fd without losing its registration
+ */
+static void rearm(int fd, int events)
+{
+	struct epoll_event ev;
+	ev.events = events;
+	ev.data.fd = fd;
+	epoll_ctl(epfd,EPOLL_CTL_MOD,fd,&ev);
+}
+#else
+#   define rearm(fd,events)
+#endif
+
+static int fdclose(Service_t *sp, int fd)
+{
+	if(sp->fd==fd)
+		sp->fd = -1;
+	if(!unwatch(fd))
+		return 0;
+	if(sp->actionf)
+		(*sp->actionf)(sp, fd, 1);
+	return 1;
 }
 
 static int fdnotify(int fd1, int fd2)
@@ -157,21 +259,16 @@ static int fdnotify(int fd1, int fd2)
 	Service_t *sp;
 	if (covered_fdnotify)
 		(*covered_fdnotify)(fd1, fd2);
+	if(fd1<0 || fd1>=nservice || !(sp = service_list[fd1]))
+		return 0;
 	if(fd2!=SH_FDCLOSE)
 	{
-		int i;
-		service_list[fd2] = service_list[fd1];
-		service_list[fd1] = 0;
-		for(i=0; i < npoll; i++)
-		{
-			if(file_list[i]==fd1)
-			{
-				file_list[i] = fd2;
-				return 0;
-			}
-		}
+		unwatch(fd1);
+		watch(sp,fd2);
+		if(sp->fd==fd1)
+			sp->fd = fd2;
 	}
-	else if(sp = service_list[fd1])
+	else
 	{
 		fdclose(sp,fd1);
 		if(--sp->refcount==0)
@@ -180,100 +277,198 @@ static int fdnotify(int fd1, int fd2)
 	return 0;
 }
 
-static void process_stream(Sfio_t* iop)
+/*
+ * queue fd if its stream still holds input that the kernel cannot report
+ */
+static void checkbuffer(int fd)
+{
+	Sfio_t	*iop;
+	int	i;
+	if(!(iop = sh.sftable[fd]))
+		return;
+	for(i=0; i < npending; i++)
+		if(pending[i]==fd)
+			return;
+	sfset(iop,SFIO_WRITE,0);
+	if(sfpoll(&iop,1,0) > 0)
+		pending[npending++] = fd;
+	sfset(iop,SFIO_WRITE,1);
+}
+
+static void process_fd(int fd)
 {
-	int r=0, fd = sffileno(iop);
-	Service_t * sp = service_list[fd];
+	int r;
+	Service_t *sp;
+	if(fd<0 || fd>=nservice || !(sp = service_list[fd]))
+		return;
 	if(fd==sp->fd)	/* connection socket */
 	{
 		struct sockaddr addr;
 		socklen_t addrlen = sizeof(addr);
-		fd = accept(fd, &addr, &addrlen);
-		service_list[fd] = sp;
+		if((fd = accept(fd, &addr, &addrlen)) < 0)
+			return;
+		if(sp->acceptf && (fd = (*sp->acceptf)(sp,fd)) < 0)
+			return;
 		sp->refcount++;
-		file_list[npoll++] = fd;
-		if(fd>=0)
-		{
-			if(sp->acceptf)
-				r = (*sp->acceptf)(sp,fd);
-		}
+		watch(sp,fd);
 	}
-	else if(sp->actionf)
+	else if(sp->actionf && !inaction[fd])
 	{
-		service_list[fd] = 0;
+		inaction[fd] = 1;
+		rearm(fd,0);
 		r = (*sp->actionf)(sp, fd, 0);
-		service_list[fd] = sp;
+		if(!inaction[fd])
+			return;		/* the action closed or moved it */
+		inaction[fd] = 0;
+		rearm(fd,EPOLLIN);
 		if(r<0)
-			close(fd);
+			sh_close(fd);	/* fdnotify() runs the close function */
+		else
+			checkbuffer(fd);
 	}
 }
 
 static int waitnotify(int fd, long timeout, int rw)
 {
-	Sfio_t	*special=0, **pstream;
-	int	i;
-
+	Sfio_t	*special=0;
+	int	i, n;
+#if SERVICE_EPOLL
+	int	added=0;	/* 1: fd added to epfd here, 2: connection rearmed */
+#endif
+	NOT_USED(rw);
 	if (fd >= 0)
-		special = sh_fd2sfio(fd);
+	{
+		/* input may already be buffered for the descriptor waited on */
+		if(special = sh_fd2sfio(fd))
+		{
+			sfset(special,SFIO_WRITE,0);
+			n = sfpoll(&special,1,0);
+			sfset(special,SFIO_WRITE,1);
+			if(n > 0)
+				return fd;
+		}
+#if SERVICE_EPOLL
+		{
+			struct epoll_event ev;
+			ev.events = EPOLLIN;
+			ev.data.fd = fd;
+			if(epoll_ctl(epfd,EPOLL_CTL_ADD,fd,&ev) == 0)
+				added = 1;
+			else if(errno!=EEXIST)
+				return fd;	/* e.g. a regular file, which is always ready */
+			else if(fd < nservice && inaction[fd])
+			{
+				/* a connection waited on by its own action */
+				rearm(fd,EPOLLIN);
+				added = 2;
+			}
+		}
+#endif
+	}
 	while(1)
 	{
-		pstream = poll_list;
+		/* finish what an earlier wait found before waiting again */
 		while(ready < nready)
-			process_stream(pstream[ready++]);
-		if(special)
-			*pstream++ = special;
-		for(i=0; i < npoll; i++)
 		{
-			if(service_list[file_list[i]])
-				*pstream++ = sh_fd2sfio(file_list[i]);
+#if SERVICE_EPOLL
+			process_fd(events[ready++].data.fd);
+#else
+			process_fd(sffileno(ready_list[ready++]));
+#endif
+		}
+		while(npending > 0)
+		{
+			n = pending[--npending];
+			if(n==fd)
+				goto found;
+			process_fd(n);
 		}
-		for(i=0; i < pstream-poll_list; i++)
-			sfset(poll_list[i],SFIO_WRITE,0);
 		nready = ready = 0;
 		errno = 0;
-#ifdef DEBUG
-		sfprintf(sfstderr,"before poll npoll=%d",pstream-poll_list);
-		for(i=0; i < pstream-poll_list; i++)
-			sfprintf(sfstderr," %d",sffileno(poll_list[i]));
-		sfputc(sfstderr,'\n');
-#endif
-		nready  = sfpoll(poll_list,pstream-poll_list,timeout);
-#ifdef DEBUG
-		sfprintf(sfstderr,"after poll nready=%d",nready);
-		for(i=0; i < nready; i++)
-			sfprintf(sfstderr," %d",sffileno(poll_list[i]));
-		sfputc(sfstderr,'\n');
-#endif
-		for(i=0; i < pstream-poll_list; i++)
+#if SERVICE_EPOLL
+		n = epoll_wait(epfd,events,MAXEVENTS,timeout<0 ? -1 : (int)timeout);
+		if(n<=0)
+			break;
+		nready = n;
+		if(fd>=0)
+		{
+			for(i=0; i < n; i++)
+			{
+				if(events[i].data.fd==fd)
+				{
+					/* leave the other events for later */
+					events[i] = events[--nready];
+					goto found;
+				}
+			}
+		}
+#else
+		n = 0;
+		if(special)
+			poll_list[n++] = special;
+		for(i=0; i < npoll; i++)
+			if(!inaction[file_list[i]])
+				poll_list[n++] = sh_fd2sfio(file_list[i]);
+		for(i=0; i < n; i++)
+			sfset(poll_list[i],SFIO_WRITE,0);
+		nready = sfpoll(poll_list,n,timeout);
+		for(i=0; i < n; i++)
 			sfset(poll_list[i],SFIO_WRITE,1);
 		if(nready<=0)
-			return errno? -1: 0;
-		if(special && poll_list[0]==special)
+			break;
+		/* sfpoll() moves the ready streams to the front */
+		memcpy(ready_list,poll_list,nready*sizeof(Sfio_t*));
+		if(special && ready_list[0]==special)
 		{
 			ready = 1;
 			return fd;
 		}
+#endif
 	}
+	n = errno ? -1 : 0;
+#if SERVICE_EPOLL
+	if(added==1)
+		epoll_ctl(epfd,EPOLL_CTL_DEL,fd,NULL);
+	else if(added==2 && inaction[fd])
+		rearm(fd,0);
+#endif
+	nready = ready = 0;
+	return n;
+found:
+#if SERVICE_EPOLL
+	if(added==1)
+		epoll_ctl(epfd,EPOLL_CTL_DEL,fd,NULL);
+	else if(added==2 && inaction[fd])
+		rearm(fd,0);
+#endif
+	return fd;
 }
 
 static int service_init(void)
 {
-	int n = 20;
-	file_list = (int*)sh_newof(NULL,short,n,0);
-	poll_list = sh_newof(NULL,Sfio_t*,n,0);
-	service_list = sh_newof(NULL,Service_t*,n,0);
+#if SERVICE_EPOLL
+	int fd;
+	if((epfd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+		return 0;
+	/* keep it out of the way of scripts that use descriptors 0 to 9 */
+	if(epfd < 10 && (fd = sh_fcntl(epfd, F_dupfd_cloexec, 10)) >= 0)
+	{
+		sh_close(epfd);
+		epfd = fd;
+	}
+#endif
 	covered_fdnotify = sh_fdnotify(fdnotify);
 	sh_waitnotify(waitnotify);
 	return 1;
 }
 
-void service_add(Service_t *sp)
+static int service_add(Service_t *sp)
 {
 	static int init;
-	if (!init)
-		init = service_init();
-	service_list[sp->fd] = sp;
-	file_list[npoll++] = sp->fd;
+	if (!init && !(init = service_init()))
+		return -1;
+	watch(sp,sp->fd);
+	return 0;
 }
 
 static int Accept(Service_t *sp, int accept_fd)
@@ -281,7 +476,8 @@ static int Accept(Service_t *sp, int accept_fd)
 	Namval_t*	nq = sp->disc[ACCEPT];
 	int		fd;
 
-	fd = fcntl(accept_fd, F_DUPFD, 10);
+	/* sh_fcntl() forgets any stale state the shell kept for the new fd */
+	fd = sh_fcntl(accept_fd, F_DUPFD, 10);
 	if (fd >= 0)
 	{
 		close(accept_fd);
@@ -378,10 +574,11 @@ static void putval(Namval_t* np, const char* val, int flag, Namfun_t* fp)
 	if (!val)
 	{
 		int i;
-		for(i=0; i< sh.lim.open_max; i++)
+		for(i=0; i < nservice; i++)
 		{
 			if(service_list[i]==sp)
 			{
+				unwatch(i);
 				close(i);
 				if(--sp->refcount<=0)
 					break;
@@ -453,7 +650,12 @@ int	b_mkservice(int argc, char** argv, Shbltin_t *context)
 	sp->node = np;
 	nv_putval(np, path, 0);
 	nv_stack(np, (Namfun_t*)sp);
-	service_add(sp);
+	if(service_add(sp) < 0)
+	{
+		nv_unset(np);
+		error(ERROR_system(1), "%s: cannot start service", path);
+		UNREACHABLE();
+	}
 	return 0;
 }
 
@@ -26,6 +26,7 @@
 #include	"shopt.h"
 #include	<ast.h>
 #include	<error.h>
+#include	<sfdisc.h>
 #include	"defs.h"
 #include	"variables.h"
 #include	"lexstates.h"
@@ -55,6 +56,7 @@ struct read_save
 	int		fd;
 	int		plen;
 	int		flags;
+	int		async;
 	ssize_t		len;
 	Sflong_t	timeout;
 };
@@ -64,11 +66,12 @@ int	b_read(int argc,char *argv[], Shbltin_t *context)
 	Sfdouble_t sec;
 	char *prompt;
 	const char *msg = e_file+4;
-	int r, flags=0, fd=0;
+	int r, flags=0, fd=0, async=0;
 	ssize_t	len=0;
 	Sflong_t timeout = sh.st.tmout && tty_check(0) ? 1000*(Sflong_t)sh.st.tmout : 0;
 	int save_prompt, fixargs=context->invariant;
 	struct read_save *rp;
+	Sfio_t *iop;
 	static char default_prompt[3] = {ESC,ESC};
 	rp = (struct read_save*)(context->data);
 	if(argc==0)
@@ -82,6 +85,7 @@ int	b_read(int argc,char *argv[], Shbltin_t *context)
 		flags = rp->flags;
 		timeout = rp->timeout;
 		fd = rp->fd;
+		async = rp->async;
 		argv = rp->argv;
 		prompt = rp->prompt;
 		r = rp->plen;
@@ -139,6 +143,9 @@ int	b_read(int argc,char *argv[], Shbltin_t *context)
 	    case 'v':
 		flags |= V_FLAG;
 		break;
+	    case -1:
+		async = 1;
+		break;
 	    case ':':
 		errormsg(SH_DICT,2, "%s", opt_info.arg);
 		break;
@@ -170,6 +177,7 @@ int	b_read(int argc,char *argv[], Shbltin_t *context)
 		context->data = (void*)rp;
 		rp->fd = fd;
 		rp->flags = flags;
+		rp->async = async;
 		rp->timeout = timeout;
 		rp->argv = argv;
 		rp->prompt = prompt;
@@ -177,6 +185,8 @@ int	b_read(int argc,char *argv[], Shbltin_t *context)
 		rp->len = len;
 	}
 bypass:
+	if(async && ((iop=sh.sftable[fd]) || (iop=sh_iostream(fd))))
+		sfdcasync(iop);
 	sh.prompt = default_prompt;
 	if(r && (sh.prompt=(char*)sfreserve(sfstderr,r,SFIO_LOCKR)))
 	{
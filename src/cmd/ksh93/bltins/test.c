@@ -78,9 +78,11 @@ static char *nxtarg(struct test*,int);
 static int expr(struct test*,int);
 static int e3(struct test*);
 
-static int test_strmatch(const char *str, const char *pat)
+/*
+ * return the number of match[] pairs needed for the groups in <pat>
+ */
+static int patgroups(const char *pat)
 {
-	int match[2*(MATCH_MAX+1)],n;
 	int c, m=0;
 	const char *cp=pat;
 	while(c = *cp++)
@@ -92,10 +94,17 @@ static int test_strmatch(const char *str, const char *pat)
 	}
 	if(m)
 		m++;
-	else
+	if(m > MATCH_MAX+1)
+		m = MATCH_MAX+1;
+	return m;
+}
+
+static int test_strmatch(const char *str, const char *pat)
+{
+	int match[2*(MATCH_MAX+1)],n;
+	int m = patgroups(pat);
+	if(m==0)
 		match[0] = 0;
-	if(m >  elementsof(match)/2)
-		m = elementsof(match)/2;
 	n = strgrpmatch(str, pat, (ssize_t*)match, m, STR_GROUP|STR_MAXIMAL|STR_LEFT|STR_RIGHT|STR_INT);
 	if(m==0 && n==1)
 		match[1] = (int)strlen(str);
@@ -104,6 +113,85 @@ static int test_strmatch(const char *str, const char *pat)
 	return n;
 }
 
+/*
+ * Compiled literal patterns of [[ ... == ... ]] and [[ ... =~ ... ]].
+ * The test node keeps a pointer to its entry in *hint. Parse trees are
+ * discarded without notice, so entries are owned here and recycled by a
+ * clock sweep; a hint is only trusted while its entry still holds the
+ * same pattern for the current locale.
+ */
+#define PATCACHE	32
+
+static struct patcache
+{
+	char		*pattern;
+	char		*locale;
+	regex_t		re;
+	int		groups;
+	char		used;
+} patcache[PATCACHE];
+static int patclock;
+
+int test_patmatch(const char *str, const char *pat, void **hint)
+{
+	struct patcache	*pp = *hint;
+	char		*locale = setlocale(LC_CTYPE,NULL);
+	regflags_t	reflags = REG_SHELL|REG_AUGMENTED;
+	regmatch_t	sub[MATCH_MAX+1];
+	int		match[2*(MATCH_MAX+1)];
+	int		i, n;
+	if(!pp || !pp->pattern || pp->locale!=locale || strcmp(pp->pattern,pat))
+	{
+		if(!*pat)
+			return test_strmatch(str,pat);
+		while((pp = &patcache[patclock])->used)
+		{
+			pp->used = 0;
+			patclock = (patclock+1)%PATCACHE;
+		}
+		patclock = (patclock+1)%PATCACHE;
+		if(pp->pattern)
+		{
+			regfree(&pp->re);
+			free(pp->pattern);
+		}
+		pp->pattern = sh_strdup(pat);
+		if(!(pp->groups = patgroups(pat)))
+			reflags |= REG_NOSUB;
+		if(regcomp(&pp->re,pp->pattern,reflags|REG_SHELL_GROUP|REG_LEFT|REG_RIGHT))
+		{
+			free(pp->pattern);
+			pp->pattern = NULL;
+			*hint = NULL;
+			return test_strmatch(str,pat);
+		}
+		pp->locale = locale;
+		*hint = pp;
+	}
+	else if(!pp->groups)
+		reflags |= REG_NOSUB;
+	pp->used = 1;
+	if(regnexec(&pp->re,str,strlen(str),pp->groups,sub,reflags))
+		return 0;
+	if(!(n = pp->groups))
+	{
+		match[0] = 0;
+		match[1] = (int)strlen(str);
+		n = 1;
+	}
+	else
+	{
+		for(i=0; i < n && i <= pp->re.re_nsub; i++)
+		{
+			match[2*i] = (int)sub[i].rm_so;
+			match[2*i+1] = (int)sub[i].rm_eo;
+		}
+		n = pp->re.re_nsub+1;
+	}
+	sh_setmatch(str, -1, n, match, 0);
+	return n;
+}
+
 static void check_toomanyops(char *argv[])
 {
 	unsigned n;
@@ -1531,7 +1531,7 @@ static int print_namval(Sfio_t *file,Namval_t *np,int flag, struct tdata *tp)
 		else
 		{
 			sfputc(file, '\n');
-			sh_deparse(file, (Shnode_t*)(rp->ptree), 2 | nv_isattr(np,NV_FPOSIX), 0);
+			sh_deparse(file, sh_tlazy((Shnode_t*)rp->ptree), 2 | nv_isattr(np,NV_FPOSIX), 0);
 		}
 		return nv_size(np) + 1;
 	}
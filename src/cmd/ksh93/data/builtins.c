@@ -1454,7 +1454,7 @@ const char sh_optpwd[] =
 ;
 
 const char sh_optread[] =
-"[-1c?\n@(#)$Id: read (ksh 93u+m) 2023-03-24 $\n]"
+"[-1c?\n@(#)$Id: read (ksh 93u+m) 2026-10-19 $\n]"
 "[--catalog?" SH_DICT "]"
 "[+NAME?read - read a line from standard input]"
 "[+DESCRIPTION?\bread\b reads a line from standard input and breaks it "
@@ -1502,6 +1502,9 @@ const char sh_optread[] =
 	"a terminal or pipe.]"
 "[v?When reading from a terminal the value of the first variable is displayed "
 	"and used as a default value.]"
+"[01:async?If the input is a regular file, ask the system to read ahead in it "
+	"while the shell processes what was read. This lasts until the file "
+	"descriptor is closed and is useful for \bwhile read\b loops over large files.]"
 "\n"
 "\n[var?prompt] [var ...]\n"
 "\n"
@@ -103,6 +103,7 @@ const struct shtable2 shtab_variables[] =
 	".sh.tilde",	0,				NULL,
 	"SHLVL",	NV_INTEGER|NV_NOFREE|NV_EXPORT,	NULL,
 	"SRANDOM",	NV_NOFREE|NV_INTEGER|NV_UNSIGN,	NULL,
+	"SHREGEX_CACHE",	0,			NULL,
 	"",	0,					NULL
 };
 
@@ -113,6 +114,7 @@ const Shtable_t shtab_stats[] =
 {
 	"arg_cachehits",	STAT_ARGHITS,
 	"arg_expands",		STAT_ARGEXPAND,
+	"arg_simplevars",	STAT_ARGSIMPLE,
 	"comsubs",		STAT_COMSUB,
 	"forks",		STAT_FORKS,
 	"funcalls",		STAT_FUNCT,
@@ -122,6 +124,9 @@ const Shtable_t shtab_stats[] =
 	"nv_opens",		STAT_NVOPEN,
 	"pathsearch",		STAT_PATHS,
 	"posixfuncall",		STAT_SVFUNCT,
+	"re_cachehits",		STAT_REHITS,
+	"re_cachemisses",	STAT_REMISSES,
+	"re_evictions",		STAT_REEVICT,
 	"simplecmds",		STAT_SCMDS,
 	"spawns",		STAT_SPAWN,
 	"subshell",		STAT_SUBSHELL
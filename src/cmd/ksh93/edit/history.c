@@ -53,11 +53,15 @@
 #define HIST_CMDNO	0202		/* next 3 bytes give command number */
 #define HIST_BSIZE	4096		/* size of history file buffer */
 #define HIST_DFLT	512		/* default size of history list */
+#define HIST_AUDITMAX	8192		/* audit records queued before waiting for the target */
 
 #if SHOPT_AUDIT
-#   define _HIST_AUDIT	Sfio_t	*auditfp; \
+#   define _HIST_AUDIT	Sfio_t	*auditfp;	/* queue of audit records */ \
 			char	*tty; \
-			int	auditmask;
+			int	auditmask; \
+			int	auditfd; \
+			char	auditrec;	/* write one record at a time */ \
+			pid_t	auditpid;	/* process that owns the queue */
 #else
 #   define _HIST_AUDIT
 #endif
@@ -357,7 +361,12 @@ retry:
 				fcntl(fd,F_SETFD,FD_CLOEXEC);
 				tty = ttyname(2);
 				hp->tty = sh_strdup(tty?tty:"notty");
-				hp->auditfp = sfnew(NULL,NULL,-1,fd,SFIO_WRITE);
+				hp->auditfd = fd;
+				/* keep datagram and pipe records apart; don't wait for a backed-up socket or pipe */
+				if(hp->auditrec = lseek(fd,0,SEEK_CUR) < 0)
+					fcntl(fd,F_SETFL,fcntl(fd,F_GETFL,0)|O_NONBLOCK);
+				hp->auditpid = sh.current_pid;
+				hp->auditfp = sfstropen();
 			}
 		}
 	}
@@ -374,9 +383,11 @@ void hist_close(History_t *hp)
 #if SHOPT_AUDIT
 	if(hp->auditfp)
 	{
+		hist_auditsync(hp,1);
 		if(hp->tty)
 			free(hp->tty);
-		sfclose(hp->auditfp);
+		sfstrclose(hp->auditfp);
+		sh_close(hp->auditfd);
 	}
 #endif /* SHOPT_AUDIT */
 	free(hp);
@@ -705,6 +716,58 @@ void hist_flush(History_t *hp)
 	}
 }
 
+#if SHOPT_AUDIT
+/*
+ * write the queued audit records
+ * each record is written before its command runs; only a socket or pipe
+ * that cannot take it yet leaves it queued, to be written when the shell
+ * is idle or, at the latest, when HIST_AUDITMAX bytes are queued
+ * if <force> is set, wait until all of them are written, as before exit or exec
+ */
+void hist_auditsync(History_t *hp, int force)
+{
+	char	*cp, *ep, *bp;
+	ssize_t	n;
+	int	block;
+	if(!hp || !hp->auditfp || !(n = sfstrtell(hp->auditfp)))
+		return;
+	cp = sfstrbase(hp->auditfp);
+	ep = cp + n;
+	if(hp->auditpid == sh.current_pid)
+	{
+		if(block = hp->auditrec && (force || n >= HIST_AUDITMAX))
+			fcntl(hp->auditfd,F_SETFL,fcntl(hp->auditfd,F_GETFL,0)&~O_NONBLOCK);
+		while(cp < ep)
+		{
+			bp = ep;
+			if(hp->auditrec)
+				bp = memchr(cp,0,ep-cp) + 1;
+			if((n = write(hp->auditfd,cp,bp-cp)) < 0)
+			{
+				if(errno==EINTR)
+					continue;
+				if(errno==EAGAIN || errno==EWOULDBLOCK)
+				{
+					/* keep the rest for later */
+					n = ep - cp;
+					memmove(sfstrbase(hp->auditfp),cp,n);
+					sfstrseek(hp->auditfp,n,SEEK_SET);
+					break;
+				}
+				cp = ep;
+				break;
+			}
+			cp += n;
+		}
+		if(block)
+			fcntl(hp->auditfd,F_SETFL,fcntl(hp->auditfd,F_GETFL,0)|O_NONBLOCK);
+		if(cp < ep)
+			return;
+	}
+	sfstrseek(hp->auditfp,0,SEEK_SET);
+}
+#endif /* SHOPT_AUDIT */
+
 /*
  * This is the write discipline for the history file
  * When called from hist_flush(), trailing newlines are deleted and
@@ -747,10 +810,16 @@ static ssize_t hist_write(Sfio_t *iop,const void *buff,size_t insize,Sfdisc_t* h
 	if(hp->auditfp)
 	{
 		time_t	t=time(NULL);
+		/* records queued by a parent process are not ours to write */
+		if(hp->auditpid != sh.current_pid)
+		{
+			sfstrseek(hp->auditfp,0,SEEK_SET);
+			hp->auditpid = sh.current_pid;
+		}
 		sfprintf(hp->auditfp, "%u;%ju;%s;%*s%c",
 			 sh_isoption(SH_PRIVILEGED) ? sh.euserid : sh.userid,
 			 (Sfulong_t)t, hp->tty, size, buff, 0);
-		sfsync(hp->auditfp);
+		hist_auditsync(hp,0);
 	}
 #endif	/* SHOPT_AUDIT */
 #if	SHOPT_ACCTFILE
@@ -136,6 +136,7 @@ extern int		sh_subsavefd(int);
 extern void		sh_subtmpfile(void);
 extern char 		*sh_substitute(const char*,const char*,char*);
 extern void		sh_timetraps(void);
+extern Shnode_t		*sh_tlazy(Shnode_t*);
 extern const char	*_sh_translate(const char*);
 extern int		sh_trace(char*[],int);
 extern void		sh_trim(char*);
@@ -218,18 +219,23 @@ extern const char	e_scriptonly[];
     /* performance statistics */
 #   define	STAT_ARGHITS	0
 #   define	STAT_ARGEXPAND	1
-#   define	STAT_COMSUB	2
-#   define	STAT_FORKS	3
-#   define	STAT_FUNCT	4
-#   define	STAT_GLOBS	5
-#   define	STAT_READS	6
-#   define	STAT_NVHITS	7
-#   define	STAT_NVOPEN	8
-#   define	STAT_PATHS	9
-#   define	STAT_SVFUNCT	10
-#   define	STAT_SCMDS	11
-#   define	STAT_SPAWN	12
-#   define	STAT_SUBSHELL	13
+#   define	STAT_ARGSIMPLE	2
+#   define	STAT_COMSUB	3
+#   define	STAT_FORKS	4
+#   define	STAT_FUNCT	5
+#   define	STAT_GLOBS	6
+#   define	STAT_READS	7
+#   define	STAT_NVHITS	8
+#   define	STAT_NVOPEN	9
+#   define	STAT_PATHS	10
+#   define	STAT_SVFUNCT	11
+#   define	STAT_REHITS	12	/* the STAT_RE* values are kept by regcache() */
+#   define	STAT_REMISSES	13
+#   define	STAT_REEVICT	14
+#   define	STAT_SCMDS	15
+#   define	STAT_SPAWN	16
+#   define	STAT_SUBSHELL	17
+#   define	STAT_NUM	18
     extern const Shtable_t shtab_stats[];
 #   define sh_stats(x)	(sh.stats[(x)]++)
 #else
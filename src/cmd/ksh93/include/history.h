@@ -57,6 +57,7 @@ typedef struct
 #define hist_copy(h)	0
 #define hist_eof(h)	0
 #define hist_flush(h)	0
+#define hist_auditsync(h,f)	0
 #define hist_list(a,out,c,d,e)	sfputr(out,sh_translate(e_unknown),'\n')
 #define hist_match(a,b,c,d)	0
 #define hist_tell(a,b)		0
@@ -79,6 +80,11 @@ extern int		hist_copy(char*, int, int, int);
 extern void 		hist_eof(History_t*);
 extern Histloc_t	hist_find(History_t*,char*,int, int, int);
 extern void 		hist_flush(History_t*);
+#if SHOPT_AUDIT
+extern void 		hist_auditsync(History_t*, int);
+#else
+#define hist_auditsync(h,f)	0
+#endif /* SHOPT_AUDIT */
 extern void 		hist_list(History_t*,Sfio_t*, off_t, int, char*);
 extern int		hist_match(History_t*,off_t, char*, int*);
 extern off_t		hist_tell(History_t*,int);
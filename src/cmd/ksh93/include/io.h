@@ -39,6 +39,7 @@
 #define IONOSEEK	020
 #define IOTTY 		040
 #define IOCLEX 		0100
+#define IOPIPEBUF	0200	/* pipe enlarged by .sh.pipebuf */
 #define IOCLOSE		(IOSEEK|IONOSEEK)
 
 #define IOSUBSHELL	0x8000	/* must be larger than any file descriptor */
@@ -183,6 +183,8 @@ extern Namval_t		*nv_arraychild(Namval_t*, Namval_t*, int);
 extern int		nv_compare(Dt_t*, void*, void*, Dtdisc_t*);
 extern void		nv_outnode(Namval_t*,Sfio_t*, int, int);
 extern int		nv_subsaved(Namval_t*, int);
+extern void		nv_uncache(Dt_t*);
+extern void		nv_uncachename(const char*, Dt_t*);
 extern void		nv_typename(Namval_t*, Sfio_t*);
 extern void		nv_newtype(Namval_t*);
 extern Namval_t		*nv_typeparent(Namval_t*);
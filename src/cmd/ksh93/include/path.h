@@ -80,6 +80,7 @@ extern int 		path_expand(const char*, struct argnod**, int);
 extern noreturn void 	path_exec(const char*,char*[],struct argnod*);
 extern pid_t		path_spawn(const char*,char*[],char*[],Pathcomp_t*,int);
 extern int		path_open(const char*,Pathcomp_t*);
+extern void		path_prefetch(Sfio_t*);
 extern Pathcomp_t 	*path_get(const char*);
 extern char 		*path_pwd(void);
 extern Pathcomp_t	*path_nextcomp(Pathcomp_t*,const char*,Pathcomp_t*);
@@ -89,6 +90,9 @@ extern int		path_complete(const char*, const char*,struct argnod**);
 #if SHOPT_BRACEPAT
     extern int 		path_generate(struct argnod*,struct argnod**, int);
 #endif /* SHOPT_BRACEPAT */
+#if SHOPT_SPAWN
+    extern char		*sh_shpath(void);
+#endif /* SHOPT_SPAWN */
 
 #if SHOPT_DYNAMIC
 /* builtin/plugin routines */
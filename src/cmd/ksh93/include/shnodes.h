@@ -68,8 +68,13 @@
 #if SHOPT_NAMESPACE
 #define TNSPACE	(TFUN|COMSCAN)
 #endif
+#define TLAZY	(TFUN|(01000<<COMBITS))	/* function body not yet restored */
 
-/* this node is a proforma for those that follow */
+/*
+ * this node is a proforma for those that follow
+ * comnod and forknod must keep their ionod pointer where treio is; in the
+ * other nodes, line numbers follow the type to share its alignment padding
+ */
 
 struct trenod
 {
@@ -106,19 +111,19 @@ struct whnod
 struct fornod
 {
 	int		fortyp;
+	int		forline;
 	char	 	*fornam;
 	Shnode_t	*fortre;
 	struct comnod	*forlst;
-	int		forline;
 };
 
 struct swnod
 {
 	int		swtyp;
+	int		swline;
 	struct argnod	*swarg;
 	struct regnod	*swlst;
 	struct ionod	*swio;
-	int		swline;
 };
 
 struct regnod
@@ -147,14 +152,15 @@ struct tstnod
 {
 	struct lstnod	tstlst;
 	int		tstline;
+	void		*tstpat;	/* compiled literal pattern; see test_patmatch() */
 };
 
 struct functnod
 {
 	int		functtyp;
+	int		functline;
 	char		*functnam;
 	Shnode_t	*functtre;
-	int		functline;
 	struct slnod	*functstak;
 	struct comnod	*functargs;
 };
@@ -167,6 +173,16 @@ struct arithnod
 	void		*arcomp;
 };
 
+/* function body from a compiled script, restored by sh_tlazy() when needed */
+struct lazynod
+{
+	int		lazytyp;
+	Shnode_t	*lazytre;	/* restored body */
+	Sfio_t		*lazystk;	/* stack of the function */
+	char		*lazybuf;	/* compiled body */
+	size_t		lazysize;
+};
+
 
 /* types of ionodes stored in iofile */
 #define IOUFD		0x3f	/* file descriptor number mask */
@@ -205,6 +221,7 @@ union Shnode_u
 	struct tstnod	tst;
 	struct functnod	funct;
 	struct arithnod	ar;
+	struct lazynod	lazy;
 };
 
 extern void			sh_freeup(void);
@@ -212,5 +229,8 @@ extern void			sh_funstaks(struct slnod*,int);
 extern Sfio_t 			*sh_subshell(Shnode_t*, volatile int, int);
 extern int			sh_tdump(Sfio_t*, const Shnode_t*);
 extern Shnode_t			*sh_trestore(Sfio_t*);
+extern void			sh_tcacheopen(int, const char*);
+extern void			sh_tcachetree(Sfio_t*, const Shnode_t*);
+extern void			sh_tcachedone(int);
 
 #endif /* _SHNODES_H */
@@ -47,7 +47,7 @@ struct shtable3
 	int		(*sh_value)(int, char*[], Shbltin_t*);
 };
 
-#define sh_lookup(name,value)	(sh_locate(name,(Shtable_t*)(value),sizeof(*(value)))->sh_number)
+#define sh_lookup(name,value)	(sh_hlocate(name,(Shtable_t*)(value),sizeof(*(value)))->sh_number)
 extern const Shtable_t		shtab_testops[];
 extern const Shtable_t		shtab_options[];
 extern const Shtable_t		shtab_attributes[];
@@ -57,6 +57,7 @@ extern const struct shtable2	shtab_signals[];
 extern const struct shtable3	shtab_builtins[];
 extern const Shtable_t		shtab_reserved[];
 extern const Shtable_t		*sh_locate(const char*, const Shtable_t*, int);
+extern const Shtable_t		*sh_hlocate(const char*, const Shtable_t*, int);
 extern int			sh_lookopt(const char*, int*);
 extern Dt_t			*sh_inittree(const struct shtable2*);
 
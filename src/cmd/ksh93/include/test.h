@@ -56,6 +56,7 @@
 extern int test_unop(int, const char*);
 extern int test_inode(const char*, const char*);
 extern int test_binop(int, const char*, const char*);
+extern int test_patmatch(const char*, const char*, void**);
 
 extern const char	sh_opttest[];
 extern const char	test_opchars[];
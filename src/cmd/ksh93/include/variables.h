@@ -113,5 +113,6 @@ extern void sh_save_rand_seed(struct rand *, int);
 #define SH_TILDENOD	(sh.bltin_nodes+64)
 #define SHLVL		(sh.bltin_nodes+65)
 #define SRANDNOD	(sh.bltin_nodes+66)
+#define SHREGEXNOD	(sh.bltin_nodes+67)
 
 #endif /* SH_VALNOD */
@@ -33,6 +33,8 @@
 #include	"builtins.h"
 #include	"terminal.h"
 #include	"edit.h"
+#include	"variables.h"
+#include	"lexstates.h"
 #include	"FEATURE/poll"
 #if SHOPT_KIA
 #   include	"shlex.h"
@@ -785,6 +787,47 @@ struct argnod *sh_argprocsub(struct argnod *argp)
 	return ap;
 }
 
+/*
+ * Fast path for an argument word that consists of nothing but "$name" or
+ * "${name}", which is by far the most common non-literal word. The parser
+ * marks such words with ARG_SIMPLEVAR. They expand to exactly one field
+ * holding the variable's value, so if the variable is a plain scalar set to
+ * a value, sh_macexpand() is not needed.
+ * Not used on the first pass through a loop (ARG_OPTIMIZE), as that pass
+ * must go through sh_macexpand() to set up the loop invariant cache.
+ * Returns 1 if the field was added to *argchain, 0 to use the slow path.
+ */
+static int arg_simplevar(struct argnod *argp, struct argnod **argchain)
+{
+	const char	*name = argp->argval+2;
+	char		id[64];
+	size_t		len = strlen(name)-1;
+	Namval_t	*np;
+	char		*val;
+	if(*name=='{')
+		name++, len -= 2;
+	if(len >= sizeof(id))
+		return 0;
+	memcpy(id,name,len);
+	id[len] = 0;
+#if SHOPT_FILESCAN
+	if(sh.cur_line && strcmp(id,REPLYNOD->nvname)==0)
+		return 0;
+#endif /* SHOPT_FILESCAN */
+	np = nv_open(id,sh.var_tree,NV_VARNAME|NV_NOADD|NV_NOFAIL);
+	if(!np || np->nvfun || nv_isattr(np,NV_ARRAY|NV_INTEGER|NV_FUNCT|NV_REF) || !np->nvalue)
+		return 0;
+	val = nv_getval(np);
+	sh_stats(STAT_ARGSIMPLE);
+	stkseek(sh.stk,ARGVAL);
+	sfputr(sh.stk,val,0);
+	argp = stkfreeze(sh.stk,0);
+	argp->argflag = ARG_RAW|ARG_MAKE;
+	argp->argchn.ap = *argchain;
+	*argchain = argp;
+	return 1;
+}
+
 /* Argument expansion */
 static int arg_expand(struct argnod *argp, struct argnod **argchain,int flag)
 {
@@ -817,7 +860,8 @@ static int arg_expand(struct argnod *argp, struct argnod **argchain,int flag)
 		}
 		else
 #endif /* SHOPT_OPTIMIZE */
-		count = sh_macexpand(argp,argchain,flag);
+		if((flag&ARG_OPTIMIZE) || !(argp->argflag&ARG_SIMPLEVAR) || !(count = arg_simplevar(argp,argchain)))
+			count = sh_macexpand(argp,argchain,flag);
 	}
 	else
 	{
@@ -334,7 +334,7 @@ static void p_tree(const Shnode_t *t,int tflags)
 			}
 			begin_line = 1;
 			p_keyword("{",BEGIN);
-			p_tree(t->funct.functtre,0);
+			p_tree(sh_tlazy(t->funct.functtre),0);
 			p_keyword("}",END);
 			break;
 
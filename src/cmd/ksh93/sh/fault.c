@@ -659,6 +659,8 @@ noreturn void sh_done(int sig)
 	if((sh_isoption(SH_INTERACTIVE) && sh_isoption(SH_LOGIN_SHELL)) || (!sh_isoption(SH_INTERACTIVE) && (sig==SIGHUP)))
 		job_walk(sfstderr, job_hup, SIGHUP, NULL);
 	job_close();
+	hist_auditsync(sh.hist_ptr,1);
+	sh_tcachedone(-1);
 	sfsync((Sfio_t*)sfstdin);
 	sfsync((Sfio_t*)sh.outpool);
 	sfsync((Sfio_t*)sfstdout);
@@ -142,6 +142,8 @@ char e_version[]	= "\n@(#)$Id: Version "
 			SH_RELEASE " $\0\n";
 
 #define RANDMASK	0x7fff
+#define REGCACHE	64	/* default SHREGEX_CACHE */
+#define REGCACHEMAX	4096
 
 #ifndef CHILD_MAX
 #   define CHILD_MAX	(1*1024)
@@ -192,6 +194,7 @@ typedef struct _init_
 #endif
 	Namfun_t	HISTFILE_init;
 	Namfun_t	HISTSIZE_init;
+	Namfun_t	SHREGEX_init;
 	Namfun_t	OPTINDEX_init;
 	Namfun_t	SECONDS_init;
 	struct rand	RAND_init;
@@ -349,6 +352,16 @@ static void put_history(Namval_t* np,const char *val,int flags,Namfun_t *fp)
 	}
 }
 
+/* Trap for SHREGEX_CACHE: the number of compiled patterns kept by regcache() */
+static void put_regcache(Namval_t* np,const char *val,int flags,Namfun_t *fp)
+{
+	Sfdouble_t	n = REGCACHE;
+	nv_putv(np, val, flags, fp);
+	if(val && (n = nv_getnum(np)) < 1)
+		n = REGCACHE;
+	regcache(NULL, n > REGCACHEMAX ? REGCACHEMAX : (regflags_t)n, NULL);
+}
+
 /* Trap for OPTINDEX */
 static void put_optindex(Namval_t* np,const char *val,int flags,Namfun_t *fp)
 {
@@ -1023,6 +1036,7 @@ static const Namdisc_t CDPATH_disc	= {  sizeof(Namfun_t), put_cdpath };
 static const Namdisc_t EDITOR_disc	= {  sizeof(Namfun_t), put_ed };
 #endif
 static const Namdisc_t HISTFILE_disc	= {  sizeof(Namfun_t), put_history };
+static const Namdisc_t SHREGEX_disc	= {  sizeof(Namfun_t), put_regcache };
 static const Namdisc_t OPTINDEX_disc	= {  sizeof(Namfun_t), put_optindex, 0, nget_optindex, 0, 0, clone_optindex };
 static const Namdisc_t SECONDS_disc	= {  sizeof(Namfun_t), put_seconds, get_seconds, nget_seconds };
 static const Namdisc_t RAND_disc	= {  sizeof(struct rand), put_rand, get_rand, nget_rand };
@@ -1223,6 +1237,30 @@ int sh_type(const char *path)
 	return t & ~(SH_TYPE_KSH|SH_TYPE_RESTRICTED);
 }
 
+#if SHOPT_SPAWN
+/*
+ * return the pathname for this interpreter
+ * this is looked up on first use, as most shells never need it
+ */
+char *sh_shpath(void)
+{
+	static char	checked;
+	char		buff[PATH_MAX+1];
+	size_t		n;
+	if(!checked)
+	{
+		checked = 1;
+		if((n = pathprog(NULL, buff, sizeof(buff))) > 0 && n <= sizeof(buff))
+		{
+			free(sh.shpath);
+			sh.shpath = sh_strdup(buff);
+		}
+	}
+	if(!sh.shpath)
+		sh.shpath = pathshell();
+	return sh.shpath;
+}
+#endif /* SHOPT_SPAWN */
 
 /*
  * initialize the shell
@@ -1288,16 +1326,13 @@ Shell_t *sh_init(int argc,char *argv[], Shinit_f userinit)
 #if SHOPT_SPAWN
 	{
 		/*
-		 * try to find the pathname for this interpreter
-		 * try using environment variable _ or argv[0]
+		 * remember a fallback pathname for this interpreter
+		 * from environment variable _ or argv[0]; sh_shpath()
+		 * asks the system only when the pathname is needed
 		 */
 		char *cp=nv_getval(L_ARGNOD);
-		char buff[PATH_MAX+1];
-		size_t n;
 		sh.shpath = 0;
-		if((n = pathprog(NULL, buff, sizeof(buff))) > 0 && n <= sizeof(buff))
-			sh.shpath = sh_strdup(buff);
-		else if((cp && (sh_type(cp)&SH_TYPE_SH)) || (argc>0 && strchr(cp= *argv,'/')))
+		if((cp && (sh_type(cp)&SH_TYPE_SH)) || (argc>0 && strchr(cp= *argv,'/')))
 		{
 			if(*cp=='/')
 				sh.shpath = sh_strdup(cp);
@@ -1696,7 +1731,7 @@ static Namfun_t	 stat_child_fun =
 
 static void stat_init(void)
 {
-	int		i,nstat = STAT_SUBSHELL+1;
+	int		i,nstat = STAT_NUM;
 	size_t		extrasize = nstat*(sizeof(int)+NV_MINSZ);
 	struct Stats	*sp = sh_newof(0,struct Stats,1,extrasize);
 	Namval_t	*np;
@@ -1712,6 +1747,9 @@ static void stat_init(void)
 		nv_setsize(np,10);
 		np->nvalue = &sh.stats[i];
 	}
+	nv_namptr(sp->nodes,STAT_REHITS)->nvalue = &regcachestat()->re_hits;
+	nv_namptr(sp->nodes,STAT_REMISSES)->nvalue = &regcachestat()->re_misses;
+	nv_namptr(sp->nodes,STAT_REEVICT)->nvalue = &regcachestat()->re_evictions;
 	sp->hdr.dsize = sizeof(struct Stats) + extrasize;
 	sp->hdr.disc = &stat_disc;
 	nv_stack(SH_STATS,&sp->hdr);
@@ -1752,6 +1790,8 @@ static Init_t *nv_init(void)
 	ip->HISTFILE_init.nofree = 1;
 	ip->HISTSIZE_init.disc = &HISTFILE_disc;
 	ip->HISTSIZE_init.nofree = 1;
+	ip->SHREGEX_init.disc = &SHREGEX_disc;
+	ip->SHREGEX_init.nofree = 1;
 	ip->OPTINDEX_init.disc = &OPTINDEX_disc;
 	ip->OPTINDEX_init.nofree = 1;
 	ip->SECONDS_init.disc = &SECONDS_disc;
@@ -1797,6 +1837,8 @@ static Init_t *nv_init(void)
 #endif
 	nv_stack(HISTFILE, &ip->HISTFILE_init);
 	nv_stack(HISTSIZE, &ip->HISTSIZE_init);
+	nv_stack(SHREGEXNOD, &ip->SHREGEX_init);
+	regcache(NULL, REGCACHE, NULL);
 	nv_stack(OPTINDNOD, &ip->OPTINDEX_init);
 	nv_stack(SECONDS, &ip->SECONDS_init);
 	nv_stack(L_ARGNOD, &ip->L_ARG_init);
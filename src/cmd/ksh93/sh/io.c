@@ -32,6 +32,7 @@
 #include	<ls.h>
 #include	<stdarg.h>
 #include	<regex.h>
+#include	<tmx.h>
 #include	"variables.h"
 #include	"path.h"
 #include	"io.h"
@@ -44,6 +45,7 @@
 #include	"FEATURE/externs"
 #include	"FEATURE/dynamic"
 #include	"FEATURE/poll"
+#include	"FEATURE/time"
 
 #ifdef	FNDELAY
 #   ifdef EAGAIN
@@ -207,6 +209,191 @@ freeaddrinfo(struct addrinfo* ap)
 
 static int	onintr(struct addrinfo*);
 
+#if _sys_poll
+#   include	<poll.h>
+#endif
+#if _sys_netinet_tcp || _hdr_netinet_tcp
+#   include	<netinet/tcp.h>
+#endif
+
+#define CONN_DELAY	250	/* ms to wait before also trying the next address (RFC 8305) */
+#define CONN_MAX	8	/* max connection attempts in progress at once */
+
+/*
+ * socket options taken from the .sh.net compound variable
+ */
+typedef struct Netopt_s
+{
+	long	timeout;	/* connect timeout in ms, or -1 for none */
+	int	nodelay;	/* TCP_NODELAY */
+	int	keepalive;	/* SO_KEEPALIVE */
+	int	sndbuf;		/* SO_SNDBUF, or 0 for default */
+	int	rcvbuf;		/* SO_RCVBUF, or 0 for default */
+} Netopt_t;
+
+static Sfdouble_t netget(const char *field, Sfdouble_t dflt)
+{
+	Namval_t	*np;
+	char		*cp, name[32];
+	/* nv_open() needs a writable name */
+	sfsprintf(name,sizeof(name),".sh.net%s%s",*field?".":"",field);
+	np = nv_open(name,sh.var_tree,NV_VARNAME|NV_NOADD|NV_NOFAIL);
+	if(!field[0])
+		return np!=0;
+	if(!np || nv_isnull(np))
+		return dflt;
+	if(nv_isattr(np,NV_INTEGER))
+		return nv_getnum(np);
+	if(!(cp = nv_getval(np)) || !*cp)
+		return dflt;
+	return sh_arith(cp);
+}
+
+static void netopts(Netopt_t *op)
+{
+	Sfdouble_t	d;
+	op->timeout = -1;
+	op->nodelay = op->keepalive = op->sndbuf = op->rcvbuf = 0;
+	if(!netget("",0))
+		return;
+	if((d = netget("timeout",-1)) >= 0)
+		op->timeout = (long)(d*1000 + .5);
+	op->nodelay = netget("nodelay",0) != 0;
+	op->keepalive = netget("keepalive",0) != 0;
+	op->sndbuf = (int)netget("sndbuf",0);
+	op->rcvbuf = (int)netget("rcvbuf",0);
+}
+
+static void netsetopts(int fd, struct addrinfo *p, Netopt_t *op)
+{
+	int on = 1;
+	if(op->sndbuf > 0)
+		setsockopt(fd, SOL_SOCKET, SO_SNDBUF, (void*)&op->sndbuf, sizeof(op->sndbuf));
+	if(op->rcvbuf > 0)
+		setsockopt(fd, SOL_SOCKET, SO_RCVBUF, (void*)&op->rcvbuf, sizeof(op->rcvbuf));
+	if(p->ai_socktype != SOCK_STREAM)
+		return;
+	if(op->keepalive)
+		setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, (void*)&on, sizeof(on));
+#ifdef TCP_NODELAY
+	if(op->nodelay && p->ai_protocol != IPPROTO_SCTP)
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (void*)&on, sizeof(on));
+#endif
+}
+
+#if _sys_poll && defined(POLLOUT) && defined(EINPROGRESS)
+/*
+ * return milliseconds on a clock that does not jump when the date is set
+ */
+static Sflong_t nowms(void)
+{
+#if _lib_clock_gettime && defined(CLOCK_MONOTONIC)
+	struct timespec tp;
+	clock_gettime(CLOCK_MONOTONIC,&tp);
+	return (Sflong_t)tp.tv_sec*1000 + tp.tv_nsec/1000000;
+#else
+	return (Sflong_t)(tmxgettime()/1000000);
+#endif
+}
+
+/*
+ * Connect to the first address in the list that answers. A new attempt is
+ * started every CONN_DELAY ms (or as soon as the previous one fails) while
+ * the earlier ones are kept going, so a dead address does not hold up the
+ * others; the first connection to complete wins. Gives up with ETIMEDOUT
+ * if nothing connects within the .sh.net.timeout deadline.
+ */
+static int inetconnect(struct addrinfo *addr, Netopt_t *op)
+{
+	struct pollfd	pfd[CONN_MAX];
+	struct addrinfo	*p = addr;
+	Sflong_t	deadline = 0, now;
+	int		n = 0, i, fd = -1, r, wait, err = ECONNREFUSED;
+	socklen_t	len;
+	if(op->timeout >= 0)
+		deadline = nowms() + op->timeout;
+	while(1)
+	{
+		/* start the next attempt */
+		while(p && n < CONN_MAX)
+		{
+			struct addrinfo *q = p;
+			p = p->ai_next;
+			if((fd = socket(q->ai_family, q->ai_socktype, q->ai_protocol)) < 0)
+			{
+				err = errno;
+				continue;
+			}
+			netsetopts(fd,q,op);
+			fcntl(fd,F_SETFL,fcntl(fd,F_GETFL,0)|O_NONBLOCK);
+			if(!connect(fd, q->ai_addr, q->ai_addrlen))
+				goto done;
+			if(errno==EINPROGRESS || errno==EINTR)
+			{
+				pfd[n].fd = fd;
+				pfd[n].events = POLLOUT;
+				n++;
+				break;
+			}
+			err = errno;
+			close(fd);
+		}
+		fd = -1;
+		if(n==0)
+			break;
+		wait = p && n < CONN_MAX ? CONN_DELAY : -1;
+		if(op->timeout >= 0)
+		{
+			if((now = nowms()) >= deadline)
+			{
+				err = ETIMEDOUT;
+				break;
+			}
+			if(wait<0 || wait>deadline-now)
+				wait = (int)(deadline-now);
+		}
+		if((r = poll(pfd, n, wait)) < 0)
+		{
+			if(errno!=EINTR)
+			{
+				err = errno;
+				break;
+			}
+			if(onintr(addr))
+				break;
+			continue;
+		}
+		for(i=0; r>0 && i < n; i++)
+		{
+			if(!pfd[i].revents)
+				continue;
+			r--;
+			len = sizeof(err);
+			if(getsockopt(pfd[i].fd, SOL_SOCKET, SO_ERROR, (void*)&err, &len) < 0)
+				err = errno;
+			if(!err)
+			{
+				fd = pfd[i].fd;
+				pfd[i] = pfd[--n];
+				goto done;
+			}
+			close(pfd[i].fd);
+			pfd[i--] = pfd[--n];
+		}
+	}
+done:
+	while(n > 0)
+		close(pfd[--n].fd);
+	if(fd < 0)
+	{
+		errno = err;
+		return -1;
+	}
+	fcntl(fd,F_SETFL,fcntl(fd,F_GETFL,0)&~O_NONBLOCK);
+	return fd;
+}
+#endif /* _sys_poll && POLLOUT && EINPROGRESS */
+
 /*
  * return <protocol>/<host>/<service> fd
  * If called with flags==O_NONBLOCK return 1 if protocol is supported
@@ -221,6 +408,7 @@ inetopen(const char* path, int flags)
 	struct addrinfo		hint;
 	struct addrinfo*	addr;
 	struct addrinfo*	p;
+	Netopt_t		op;
 	int			server = !!(flags&O_SERVICE);
 
 	memset(&hint, 0, sizeof(hint));
@@ -283,6 +471,21 @@ inetopen(const char* path, int flags)
 	oerrno = errno;
 	errno = 0;
 	fd = -1;
+	netopts(&op);
+#if _sys_poll && defined(POLLOUT) && defined(EINPROGRESS)
+	if (!server)
+	{
+		for (p = addr; p; p = p->ai_next)
+		{
+			if (!p->ai_protocol)
+				p->ai_protocol = hint.ai_protocol;
+			if (!p->ai_socktype)
+				p->ai_socktype = hint.ai_socktype;
+		}
+		fd = inetconnect(addr, &op);
+		goto done;
+	}
+#endif
 	for (p = addr; p; p = p->ai_next)
 	{
 		/*
@@ -295,6 +498,7 @@ inetopen(const char* path, int flags)
 			p->ai_socktype = hint.ai_socktype;
 		while ((fd = socket(p->ai_family, p->ai_socktype, p->ai_protocol)) >= 0)
 		{
+			netsetopts(fd, p, &op);
 			if (server && !bind(fd, p->ai_addr, p->ai_addrlen) && !listen(fd, 5) || !server && !connect(fd, p->ai_addr, p->ai_addrlen))
 				goto done;
 			close(fd);
@@ -331,6 +535,7 @@ static int  	eval_exceptf(Sfio_t*, int, void*, Sfdisc_t*);
 static int  	slowexcept(Sfio_t*, int, void*, Sfdisc_t*);
 static int	pipeexcept(Sfio_t*, int, void*, Sfdisc_t*);
 static ssize_t	piperead(Sfio_t*, void*, size_t, Sfdisc_t*);
+static int	pipegetsize(int,int);
 static ssize_t	slowread(Sfio_t*, void*, size_t, Sfdisc_t*);
 static ssize_t	subread(Sfio_t*, void*, size_t, Sfdisc_t*);
 static ssize_t	tee_write(Sfio_t*,const void*,size_t,Sfdisc_t*);
@@ -340,6 +545,7 @@ static void	sftrack(Sfio_t*,int,void*);
 static const Sfdisc_t eval_disc = { NULL, NULL, NULL, eval_exceptf, NULL};
 static Sfdisc_t tee_disc = {NULL,tee_write,NULL,NULL,NULL};
 static Sfio_t	*subopen(Sfio_t*, off_t, long);
+static Sfio_t	*io_stream(int, int);
 static const Sfdisc_t sub_disc = { subread, 0, 0, subexcept, 0 };
 
 struct subfile
@@ -386,6 +592,11 @@ static short		filemapsize;
 
 /* ======== input output and file copying ======== */
 
+/*
+ * Make room for fd in sh.sftable, sh.fdptrs and sh.fdstatus.
+ * These are only ever indexed by fd; the restore, subshell and fork
+ * paths walk the filemap of saved descriptors, never the whole tables.
+ */
 int  sh_iovalidfd(int fd)
 {
 	Sfio_t		**sftable = sh.sftable;
@@ -404,7 +615,10 @@ int  sh_iovalidfd(int fd)
 		errno = EBADF;
 		return 0;
 	}
+	/* grow geometrically so that opening many descriptors takes linear time */
 	n = (fd+16)&~0xf;
+	if(n < 2*sh.lim.open_max)
+		n = 2*sh.lim.open_max;
 	if(n > max)
 		n = max;
 	max = sh.lim.open_max;
@@ -533,10 +747,18 @@ static int outexcept(Sfio_t *iop,int type,void *data,Sfdisc_t *handle)
  * the sh.outpool synchronization pool
  */
 Sfio_t *sh_iostream(int fd)
+{
+	return io_stream(fd,sh_iocheckfd(fd));
+}
+
+/*
+ * as above, but with the attributes <status> for <fd>
+ */
+static Sfio_t *io_stream(int fd, int status)
 {
 	Sfio_t *iop;
-	int status = sh_iocheckfd(fd);
 	int flags = SFIO_WRITE;
+	int size = IOBSIZE;
 	char *bp;
 	Sfdisc_t *dp;
 	if(status==IOCLOSE)
@@ -552,24 +774,27 @@ Sfio_t *sh_iostream(int fd)
 		}
 		return NULL;
 	}
+	/* match the buffer to a pipe enlarged by .sh.pipebuf */
+	if((status&(IOPIPEBUF|IOTTY))==IOPIPEBUF && (size = pipegetsize(fd,!(status&IOREAD))) < IOBSIZE)
+		size = IOBSIZE;
 	if(status&IOREAD)
 	{
-		bp = (char *)sh_malloc(IOBSIZE+1);
+		bp = (char *)sh_malloc(size+1);
 		flags |= SFIO_READ;
 		if(!(status&IOWRITE))
 			flags &= ~SFIO_WRITE;
 	}
 	else
-		bp = sh.outbuff;
+		bp = size > IOBSIZE ? NULL : sh.outbuff;
 	if(status&IODUP)
 		flags |= SFIO_SHARE|SFIO_PUBLIC;
 	if((iop = sh.sftable[fd]) && sffileno(iop)>=0)
 	{
 		if(status&IOTTY)
 			sfset(iop,SFIO_LINE|SFIO_WCWIDTH,1);
-		sfsetbuf(iop, bp, IOBSIZE);
+		sfsetbuf(iop, bp, size);
 	}
-	else if(!(iop=sfnew((fd<=2?iop:0),bp,IOBSIZE,fd,flags)))
+	else if(!(iop=sfnew((fd<=2?iop:0),bp,size,fd,flags)))
 		return NULL;
 	dp = sh_newof(0,Sfdisc_t,1,0);
 	if(status&IOREAD)
@@ -641,6 +866,49 @@ static void io_preserve(Sfio_t *sp, int f2)
 	sh.sftable[f2] = 0;
 }
 
+/*
+ * Make <f2> a duplicate of <f1> with one dup2() call, doing the bookkeeping
+ * of sh_close(f2) followed by sh_fcntl(f1,F_DUPFD,f2) without the close(2)
+ * A stream on <f2> is detached from it first so that closing it leaves <f2> open
+ */
+static int io_dup2(int f1, int f2)
+{
+	Sfio_t *sp;
+	int r;
+	if(f2 >= sh.lim.open_max)
+		sh_iovalidfd(f2);
+	if(sp=sh.sftable[f2])
+	{
+		sfsetfd(sp,-1);
+		sfclose(sp);
+	}
+	else if(fdnotify)
+		(*fdnotify)(f2,SH_FDCLOSE);
+	if(f2>2)
+		sh.sftable[f2] = 0;
+	if(sh.fdptrs[f2])
+		*sh.fdptrs[f2] = -1;
+	sh.fdptrs[f2] = 0;
+	if(f2 < 10)
+		sh.inuse_bits &= ~(1<<f2);
+	while((r=dup2(f1,f2)) < 0 && errno==EINTR)
+		errno = 0;
+	if(r < 0)
+	{
+		int err = errno;
+		close(f2);
+		sh.fdstatus[f2] = IOCLOSE;
+		errno = err;
+		return r;
+	}
+	if(sh.fdstatus[f1] == IOCLOSE)
+		sh.fdstatus[f1] = 0;
+	sh.fdstatus[f2] = (sh.fdstatus[f1]&~IOCLEX);
+	if(fdnotify)
+		(*fdnotify)(f1,f2);
+	return f2;
+}
+
 /*
  * Given a file descriptor <f1>, move it to a file descriptor number <f2>
  * If <f2> is needed move it, otherwise it is closed first.
@@ -661,19 +929,31 @@ int sh_iorenumber(int f1,int f2)
 		}
 		else if(f2==0)
 			sh.st.ioset = 1;
-		sh_close(f2);
-		if(f2<=2 && sp)
+		if(f2<=2 && sp && sh.sftable[f1])
 		{
+			/* move the stream already open on f1 */
 			Sfio_t *spnew = sh_iostream(f1);
+			sh_close(f2);
 			sh.fdstatus[f2] = (sh.fdstatus[f1]&~IOCLEX);
 			sfsetfd(spnew,f2);
 			sfswap(spnew,sp);
 			sfset(sp,SFIO_SHARE|SFIO_PUBLIC,1);
 		}
+		else if(f2<=2 && sp)
+		{
+			int status = sh_iocheckfd(f1);
+			if(io_dup2(f1,f2) < 0)
+			{
+				errormsg(SH_DICT,ERROR_system(1),e_file+4);
+				UNREACHABLE();
+			}
+			/* the closed standard stream is reopened in place on f2 */
+			sp = io_stream(f2,status);
+			sfset(sp,SFIO_SHARE|SFIO_PUBLIC,1);
+		}
 		else
 		{
-			sh.fdstatus[f2] = (sh.fdstatus[f1]&~IOCLEX);
-			if((f2 = sh_fcntl(f1,F_DUPFD, f2)) < 0)
+			if((f2 = io_dup2(f1,f2)) < 0)
 			{
 				errormsg(SH_DICT,ERROR_system(1),e_file+4);
 				UNREACHABLE();
@@ -906,12 +1186,76 @@ int sh_iomovefd(int fdold)
 	return fdnew;
 }
 
+/*
+ * return the pipe buffer size in bytes requested by .sh.pipebuf, or 0
+ */
+static int pipebufsize(void)
+{
+	Namval_t	*np;
+	char		*cp, *ep, name[] = ".sh.pipebuf";
+	Sflong_t	n;
+	if(!(np = nv_open(name,sh.var_tree,NV_VARNAME|NV_NOADD|NV_NOFAIL)) || nv_isnull(np))
+		return 0;
+	if(nv_isattr(np,NV_INTEGER))
+		n = (Sflong_t)nv_getnum(np);
+	else if(!(cp = nv_getval(np)) || (n = strtonll(cp,&ep,NULL,0), *ep))
+		return 0;
+	if(n <= 0)
+		return 0;
+	return n > INT_MAX ? INT_MAX : (int)n;
+}
+
+/*
+ * ask the kernel for <size> bytes of buffer in the pipe pv, which may
+ * be a socket pair; return IOPIPEBUF if its buffer is now larger than
+ * IOBSIZE, so that the streams for its ends are sized to match, else 0
+ */
+static int pipesetsize(int pv[], int size)
+{
+	if(size <= 0)
+		return 0;
+#ifdef F_SETPIPE_SZ
+	if(fcntl(pv[1],F_SETPIPE_SZ,size) >= 0)
+		return pipegetsize(pv[1],1) > IOBSIZE ? IOPIPEBUF : 0;
+	if(errno!=EBADF && errno!=EINVAL)
+		return 0;
+#endif
+#ifdef SO_SNDBUF
+	if(setsockopt(pv[1],SOL_SOCKET,SO_SNDBUF,(void*)&size,sizeof(size)) >= 0)
+	{
+		setsockopt(pv[0],SOL_SOCKET,SO_RCVBUF,(void*)&size,sizeof(size));
+		return pipegetsize(pv[1],1) > IOBSIZE ? IOPIPEBUF : 0;
+	}
+#endif
+	return 0;
+}
+
+/*
+ * return the buffer size of the pipe or socket pair end <fd>, or -1
+ */
+static int pipegetsize(int fd, int out)
+{
+	int		n = -1;
+#ifdef F_GETPIPE_SZ
+	if((n = fcntl(fd,F_GETPIPE_SZ)) >= 0)
+		return n;
+#endif
+#ifdef SO_SNDBUF
+	{
+		socklen_t	len = sizeof(n);
+		if(getsockopt(fd,SOL_SOCKET,out?SO_SNDBUF:SO_RCVBUF,(void*)&n,&len) < 0)
+			n = -1;
+	}
+#endif
+	return n;
+}
+
 /*
  * create a pipe and print message on failure
  */
 int	sh_pipe(int pv[])
 {
-	int fd[2];
+	int fd[2], big;
 #ifdef pipe
 	if(sh_isoption(SH_POSIX))
 		return sh_rpipe(pv);
@@ -921,10 +1265,11 @@ int	sh_pipe(int pv[])
 		errormsg(SH_DICT,ERROR_system(1),e_pipe);
 		UNREACHABLE();
 	}
+	big = pipesetsize(fd,pipebufsize());
 	pv[0] = sh_iomovefd(pv[0]);
 	pv[1] = sh_iomovefd(pv[1]);
-	sh.fdstatus[pv[0]] = IONOSEEK|IOREAD;
-	sh.fdstatus[pv[1]] = IONOSEEK|IOWRITE;
+	sh.fdstatus[pv[0]] = IONOSEEK|IOREAD|big;
+	sh.fdstatus[pv[1]] = IONOSEEK|IOWRITE|big;
 	sh_subsavefd(pv[0]);
 	sh_subsavefd(pv[1]);
 	return 0;
@@ -940,16 +1285,17 @@ int	sh_pipe(int pv[])
    /* create a real pipe when pipe() is socketpair */
    int	sh_rpipe(int pv[])
    {
-	int fd[2];
+	int fd[2], big;
 	if(pipe(fd)<0 || (pv[0]=fd[0])<0 || (pv[1]=fd[1])<0)
 	{
 		errormsg(SH_DICT,ERROR_system(1),e_pipe);
 		UNREACHABLE();
 	}
+	big = pipesetsize(fd,pipebufsize());
 	pv[0] = sh_iomovefd(pv[0]);
 	pv[1] = sh_iomovefd(pv[1]);
-	sh.fdstatus[pv[0]] = IONOSEEK|IOREAD;
-	sh.fdstatus[pv[1]] = IONOSEEK|IOWRITE;
+	sh.fdstatus[pv[0]] = IONOSEEK|IOREAD|big;
+	sh.fdstatus[pv[1]] = IONOSEEK|IOWRITE|big;
 	sh_subsavefd(pv[0]);
 	sh_subsavefd(pv[1]);
 	return 0;
@@ -1683,8 +2029,12 @@ void sh_iosave(int origfd, int oldtop, char *name)
 		filemap = (struct fdsave*)sh_realloc(filemap,filemapsize*sizeof(struct fdsave));
 		if(moved = (char*)filemap - oldptr)
 		{
-			for(savefd=sh.lim.open_max; --savefd>=0; )
+			/* only saved descriptors can point into the table */
+			int i;
+			for(i=0; i < sh.topfd; i++)
 			{
+				if((savefd = filemap[i].save_fd) < 0 || savefd >= sh.lim.open_max)
+					continue;
 				cp = (char*)sh.fdptrs[savefd];
 				if(cp >= oldptr && cp < oldend)
 					sh.fdptrs[savefd] = (int*)(cp+moved);
@@ -1703,13 +2053,23 @@ void sh_iosave(int origfd, int oldtop, char *name)
 		savefd = -1;
 	else
 	{
-		if((savefd = sh_fcntl(origfd, F_DUPFD, 10)) < 0 && errno!=EBADF)
+		/* the saved copy is made close-on-exec in the same call */
+		if((savefd = fcntl(origfd, F_dupfd_cloexec, 10)) < 0 && errno!=EBADF)
 		{
 			sh.toomany=1;
 			((struct checkpt*)sh.jmplist)->mode = SH_JMPERREXIT;
 			errormsg(SH_DICT,ERROR_system(1),e_toomany);
 			UNREACHABLE();
 		}
+		if(savefd >= 0)
+		{
+			if(savefd >= sh.lim.open_max)
+				sh_iovalidfd(savefd);
+			if(sh.fdstatus[origfd] == IOCLOSE)
+				sh.fdstatus[origfd] = 0;
+			if(fdnotify)
+				(*fdnotify)(origfd,savefd);
+		}
 	}
 	filemap[sh.topfd].tname = name;
 	filemap[sh.topfd].subshell = (flag&IOSUBSHELL);
@@ -1718,8 +2078,10 @@ void sh_iosave(int origfd, int oldtop, char *name)
 	if(savefd >=0)
 	{
 		Sfio_t* sp = sh.sftable[origfd];
+#if F_dupfd_cloexec == F_DUPFD
 		/* make saved file close-on-exec */
-		sh_fcntl(savefd,F_SETFD,FD_CLOEXEC);
+		fcntl(savefd,F_SETFD,FD_CLOEXEC);
+#endif
 		if(origfd==job.fd)
 			job.fd = savefd;
 		sh.fdstatus[savefd] = sh.fdstatus[origfd];
@@ -1794,10 +2156,9 @@ void	sh_iorestore(int last, int jmpval)
 		}
 		else if(filemap[fd].tname)
 			io_usename(filemap[fd].tname,NULL,origfd,sh.exitval?2:1);
-		sh_close(origfd);
 		if ((savefd = filemap[fd].save_fd) >= 0)
 		{
-			sh_fcntl(savefd, F_DUPFD, origfd);
+			io_dup2(savefd, origfd);
 			if(savefd==job.fd)
 				job.fd=origfd;
 			sh.fdstatus[origfd] = sh.fdstatus[savefd];
@@ -1816,7 +2177,10 @@ void	sh_iorestore(int last, int jmpval)
 			sh_close(savefd);
 		}
 		else
+		{
+			sh_close(origfd);
 			sh.fdstatus[origfd] = IOCLOSE;
+		}
 	}
 	if(!flag)
 	{
@@ -2159,6 +2523,8 @@ static int	io_prompt(Sfio_t *iop,int flag)
 		case 1:
 		{
 			int c;
+			/* idle between commands: write queued audit records */
+			hist_auditsync(sh.hist_ptr,0);
 			sh_lexopen(sh.lex_context, 0);   /* reset lexer state */
 			cp = sh_mactry(nv_getval(sh_scoped(PS1NOD)));
 			sh.exitval = 0;  /* avoid sending a signal on termination */
@@ -1264,6 +1264,8 @@ int	job_wait(pid_t pid)
 		pid = -pid;
 		intr = 1;
 	}
+	if(pid > 1)
+		hist_auditsync(sh.hist_ptr,0);
 	job_lock();
 	if(pid==0)
 	{
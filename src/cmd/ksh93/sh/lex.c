@@ -74,6 +74,7 @@ static void		setupalias(Lex_t*,const char*, Namval_t*);
 static int		comsub(Lex_t*,int);
 static void		nested_here(Lex_t*);
 static int		here_copy(Lex_t*, struct ionod*);
+static void		skipregular(const char*);
 static int 		stack_grow(void);
 static const Sfdisc_t alias_disc = { NULL, NULL, NULL, alias_exceptf, NULL };
 
@@ -311,6 +312,7 @@ int sh_lex(Lex_t* lp)
 	{
 		/* skip over characters in the current state */
 		state = sh_lexstates[mode];
+		skipregular(state);
 		while((n=STATE(state,c))==0);
 		switch(n)
 		{
@@ -387,6 +389,8 @@ int sh_lex(Lex_t* lp)
 					lp->lexd.nocopy--;
 				do
 				{
+					do
+						fcseek(strcspn(fcseek(0),"\n"));
 					while((c = fcgetc()) > 0 && c!='\n');
 					if(c<=0 || lp->heredoc)
 					{
@@ -1512,6 +1516,9 @@ breakloop:
 				&& (!sh_isstate(SH_NOALIAS) || nv_isattr(np,NV_NOFREE))
 				&& (state=nv_getval(np)))
 			{
+				/* the compiled trees of this file would depend on the alias */
+				if(fcfile())
+					sh_tcachedone(sffileno(fcfile()));
 				setupalias(lp,state,np);
 				nv_onattr(np,NV_NOEXPAND);
 				lp->lex.reservok = 1;
@@ -1794,6 +1801,30 @@ void sh_lexskip(Lex_t *lp,int close, int copy, int  state)
 #   define sfwrite	_sfwrite
 #endif /* SHOPT_CRNL */
 
+/*
+ * skip the characters at the current input position that are ordinary in
+ * <state>, looking at plain bytes instead of going through STATE()
+ * in a multibyte locale, this stops at the first non-ASCII byte
+ * the buffer always ends in a null byte, which is never ordinary
+ */
+static void skipregular(const char *state)
+{
+	const unsigned char *cp = _Fcin.fcptr;
+	if(mbwide())
+	{
+		while(!state[*cp] && *cp < 0x80)
+			cp++;
+	}
+	else
+	{
+		while(!state[cp[0]] && !state[cp[1]] && !state[cp[2]] && !state[cp[3]])
+			cp += 4;
+		while(!state[*cp])
+			cp++;
+	}
+	_Fcin.fcptr = (unsigned char*)cp;
+}
+
 /*
  * read in here-document from script
  * quoted here documents, and here-documents without special chars are
@@ -1845,6 +1876,7 @@ static int here_copy(Lex_t *lp,struct ionod *iop)
 		if(n!=S_NL)
 		{
 			/* skip over regular characters */
+			skipregular(state);
 			do
 			{
 				if(mbsize(fcseek(0)) < 0 && fcleft() < MB_LEN_MAX)
@@ -372,7 +372,9 @@ static void	exfile(Sfio_t *iop,int fno)
 			}
 			fcntl(fno,F_SETFD,FD_CLOEXEC);
 			sh.fdstatus[fno] |= IOCLEX;
+			sh_tcacheopen(fno,sh.st.filename);
 			iop = sh_iostream(fno);
+			path_prefetch(iop);
 		}
 		else
 			iop = sfstdin;
@@ -570,6 +572,8 @@ static void	exfile(Sfio_t *iop,int fno)
 		job.waitall = job.curpgid = 0;
 		error_info.flags |= ERROR_INTERACTIVE;
 		t = (Shnode_t*)sh_parse(iop,0);
+		if(fno>0)
+			sh_tcachetree(iop,t);
 		if(!sh_isstate(SH_INTERACTIVE) && !sh_isoption(SH_CFLAG))
 			error_info.flags &= ~ERROR_INTERACTIVE;
 		sh.readscript = 0;
@@ -612,7 +616,10 @@ done:
 	else if(jmpval == SH_JMPEXIT)
 		sh_done(0);
 	if(fno>0)
+	{
+		sh_tcachedone(fno);
 		sh_close(fno);
+	}
 	if(sh.st.filename)
 		free(sh.st.filename);
 	sh.st.filename = 0;
@@ -32,7 +32,8 @@
 #include	"FEATURE/externs"
 #include	"streval.h"
 
-#define NVCACHE		8	/* must be a power of 2 */
+#define NVCACHE		64	/* must be a power of 2 */
+#define SCOPEPOOL	16	/* number of empty scope dictionaries kept for reuse */
 static char	*savesub = 0;
 static Namval_t	NullNode;
 static Dt_t	*Refdict;
@@ -78,19 +79,108 @@ struct sh_type
 		Namval_t	*np;
 		Namval_t	*last_table;
 		Namval_t	*namespace;
+		unsigned int	gen;
 		int		flags;
 		short		size;
 		short		len;
 	} entries[NVCACHE];
-	short		index;
+	unsigned int	gen;
 	short		ok;
     };
     static struct Namcache nvcache;
+
+/*
+ * Return the cache slot for variable <name> looked up in <root> with nv_open()
+ * <flags>. The hash stops at the end of the name proper, so that "foo",
+ * "foo=bar" and "foo+=bar" all map to the same slot.
+ */
+static unsigned int nvcache_hash(const char *name, Dt_t *root, int flags)
+{
+	unsigned int	h = (unsigned int)((uintptr_t)root >> 4) ^ (flags&(NV_ARRAY|NV_NOSCOPE));
+	int		c;
+	while((c = *(unsigned char*)name++) && c!='=' && c!='+')
+		h = h*31 + c;
+	h ^= h >> 11;
+	return (h ^ (h >> 5)) & (NVCACHE-1);
+}
 #endif
 
+/*
+ * Invalidate the variable lookup cache.
+ * If <root> is not NULL, only entries for lookups in <root> are invalidated.
+ */
+void nv_uncache(Dt_t *root)
+{
+#if NVCACHE
+	int			c;
+	struct Cache_entry	*xp;
+	if(!root)
+	{
+		nvcache.gen++;
+		return;
+	}
+	for(c=0,xp=nvcache.entries ; c < NVCACHE; xp= &nvcache.entries[++c])
+	{
+		if(xp->root==root)
+			xp->root = 0;
+	}
+#else
+	NOT_USED(root);
+#endif
+}
+
+/*
+ * Invalidate the cache entries for looking up the variable <name> in <root>.
+ */
+void nv_uncachename(const char *name, Dt_t *root)
+{
+#if NVCACHE
+	static const int	flags[] = { 0, NV_ARRAY, NV_NOSCOPE, NV_ARRAY|NV_NOSCOPE };
+	struct Cache_entry	*xp;
+	int			c;
+	for(c=0; c < elementsof(flags); c++)
+	{
+		xp = &nvcache.entries[nvcache_hash(name,root,flags[c])];
+		if(xp->root==root && strcmp(xp->name,name)==0)
+			xp->root = 0;
+	}
+#else
+	NOT_USED(name);
+	NOT_USED(root);
+#endif
+}
+
 char		nv_local = 0;
 static void(*nullscan)(Namval_t*,void*);
 
+/*
+ * A scope dictionary is created and destroyed on every call of a ksh function
+ * and for every command with a prefix assignment list. Most of these are left
+ * empty by sh_unscope(), so keep some around instead of calling dtopen() and
+ * dtclose() for each one.
+ * The lookup cache keeps entries for a pooled scope as long as it is given the
+ * same view when it is used again; they are invalidated when the view changes.
+ */
+static struct
+{
+	Dt_t		*dict[SCOPEPOOL];
+	Dt_t		*view[SCOPEPOOL];	/* view of dict when it was pooled */
+	int		n;
+} scopepool;
+
+/*
+ * let <scope> view <view>; <oldview> is the view its cached lookups were made through
+ */
+static void scopeview(Dt_t *scope, Dt_t *view, Dt_t **oldview)
+{
+	if(view != *oldview)
+	{
+		nv_uncache(scope);
+		*oldview = view;
+	}
+	dtview(scope,view);
+}
+
 /* ========	name value pair routines	======== */
 
 #include	"shnodes.h"
@@ -1430,21 +1520,17 @@ Namval_t *nv_open(const char *name, Dt_t *root, int flags)
 	if(c= !isaletter(c))
 		goto skip;
 #if NVCACHE
-	for(c=0,xp=nvcache.entries ; c < NVCACHE; xp= &nvcache.entries[++c])
-	{
-		if(xp->root!=root)
-			continue;
-		if(xp->namespace==sh.namespace && (flags&(NV_ARRAY|NV_NOSCOPE))==xp->flags && strncmp(xp->name,name,xp->len)==0 && (name[xp->len]==0 || name[xp->len]=='=' || name[xp->len]=='+'))
-		{
-			sh_stats(STAT_NVHITS);
-			np = xp->np;
-			cp = (char*)name+xp->len;
-			if(nv_isarray(np) && !(flags&NV_MOVE))
-				 nv_putsub(np,NULL,ARRAY_UNDEF);
-			sh.last_table = xp->last_table;
-			sh.last_root = xp->last_root;
-			goto nocache;
-		}
+	xp = &nvcache.entries[nvcache_hash(name,root,flags)];
+	if(xp->root==root && xp->gen==nvcache.gen && xp->namespace==sh.namespace && (flags&(NV_ARRAY|NV_NOSCOPE))==xp->flags && strncmp(xp->name,name,xp->len)==0 && (name[xp->len]==0 || name[xp->len]=='=' || name[xp->len]=='+'))
+	{
+		sh_stats(STAT_NVHITS);
+		np = xp->np;
+		cp = (char*)name+xp->len;
+		if(nv_isarray(np) && !(flags&NV_MOVE))
+			 nv_putsub(np,NULL,ARRAY_UNDEF);
+		sh.last_table = xp->last_table;
+		sh.last_root = xp->last_root;
+		goto nocache;
 	}
 	nvcache.ok = 1;
 #endif
@@ -1453,16 +1539,17 @@ Namval_t *nv_open(const char *name, Dt_t *root, int flags)
 #if NVCACHE
 	if(np && nvcache.ok && cp[-1]!=']')
 	{
-		xp = &nvcache.entries[nvcache.index];
 		if(*cp)
 		{
 			char *sp = strchr(name,*cp);
 			if(!sp)
 				goto nocache;
-			xp->len = sp-name;
+			c = sp-name;
 		}
 		else
-			xp->len = strlen(name);
+			c = strlen(name);
+		xp = &nvcache.entries[nvcache_hash(name,root,flags)];
+		xp->len = c;
 		c = roundof(xp->len+1,32);
 		if(c > xp->size)
 			xp->name = sh_realloc(xp->name, xp->size = c);
@@ -1474,7 +1561,7 @@ Namval_t *nv_open(const char *name, Dt_t *root, int flags)
 		xp->last_table = sh.last_table;
 		xp->last_root = sh.last_root;
 		xp->flags = (flags&(NV_ARRAY|NV_NOSCOPE));
-		nvcache.index = (nvcache.index+1)&(NVCACHE-1);
+		xp->gen = nvcache.gen;
 	}
 nocache:
 	nvcache.ok = 0;
@@ -2253,16 +2340,22 @@ int nv_scan(Dt_t *root, void (*fn)(Namval_t*,void*), void *data,int mask, int fl
  */
 void sh_scope(struct argnod *envlist, int fun)
 {
-	Dt_t		*newscope, *newroot=sh.var_base;
+	Dt_t		*newscope, *newroot=sh.var_base, *oldview=0;
 	struct Ufunction	*rp;
 #if SHOPT_NAMESPACE
 	if(sh.namespace)
 		newroot = nv_dict(sh.namespace);
 #endif /* SHOPT_NAMESPACE */
-	newscope = dtopen(&_Nvdisc,Dtoset);
+	if(scopepool.n)
+	{
+		newscope = scopepool.dict[--scopepool.n];
+		oldview = scopepool.view[scopepool.n];
+	}
+	else	/* may have the address of a closed scope; oldview==0 invalidates its lookups */
+		newscope = dtopen(&_Nvdisc,Dtoset);
 	if(envlist)
 	{
-		dtview(newscope,(Dt_t*)sh.var_tree);
+		scopeview(newscope,sh.var_tree,&oldview);
 		sh.var_tree = newscope;
 		nv_setlist(envlist,NV_EXPORT|NV_NOSCOPE|NV_IDENT|NV_ASSIGN,0);
 		if(!fun)
@@ -2274,7 +2367,7 @@ void sh_scope(struct argnod *envlist, int fun)
 		dtview(rp->sdict,newroot);
 		newroot = rp->sdict;
 	}
-	dtview(newscope,(Dt_t*)newroot);
+	scopeview(newscope,newroot,&oldview);
 	sh.var_tree = newscope;
 }
 
@@ -3420,6 +3513,7 @@ void sh_unscope(void)
 {
 	Dt_t *root = sh.var_tree;
 	Dt_t *dp = dtview(root,NULL);
+	Dt_t *view = dp;
 	if(dp)
 	{
 		table_unset(root,NV_RDONLY|NV_NOSCOPE,dp);
@@ -3429,7 +3523,14 @@ void sh_unscope(void)
 			sh.st.real_fun->sdict->view = dp;
 		}
 		sh.var_tree=dp;
-		dtclose(root);
+		if(scopepool.n < SCOPEPOOL && !dtvcount(root) && !dtfirst(root))
+		{
+			/* its local nodes are gone, and with them their cache entries */
+			scopepool.view[scopepool.n] = view;
+			scopepool.dict[scopepool.n++] = root;
+		}
+		else
+			dtclose(root);
 	}
 }
 
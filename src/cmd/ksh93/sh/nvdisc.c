@@ -990,7 +990,7 @@ int nv_clone(Namval_t *np, Namval_t *mp, int flags)
 Namval_t *nv_search(const char *name, Dt_t *root, int mode)
 {
 	Namval_t *np;
-	Dt_t *dp = 0;
+	Dt_t *dp = 0, *oroot = root;
 	/* do not find builtins when using 'command -x' */
 	if(!(mode&NV_ADD) && sh_isstate(SH_XARG) && (root==sh.bltin_tree || root==sh.fun_tree))
 		return NULL;
@@ -1022,6 +1022,13 @@ Namval_t *nv_search(const char *name, Dt_t *root, int mode)
 				root = next;
 		}
 		np = (Namval_t*)dtinsert(root,newnode(name));
+		/* a new local node may hide a node in an outer scope that nv_open() has cached */
+		if(dp)
+		{
+			nv_uncachename(name,oroot);
+			if(sh.var_tree!=oroot)
+				nv_uncachename(name,sh.var_tree);
+		}
 	}
 	if(dp)
 		dtview(root,dp);
@@ -1297,6 +1304,8 @@ static void put_table(Namval_t* np, const char* val, int flags, Namfun_t* fp)
 		dtdelete(root,mp);
 		free(mp);
 	}
+	/* its nodes are freed without nv_delete(), so drop cached lookups of them */
+	nv_uncache(NULL);
 	if(sh.last_root==root)
 		sh.last_root = NULL;
 	dtclose(root);
@@ -555,6 +555,8 @@ static void put_type(Namval_t* np, const char* val, int flag, Namfun_t* fp)
 			if(!nv_hasdisc(nq,&type_disc))
 				_nv_unset(nq,flag|NV_TYPE|nv_isattr(nq,NV_RDONLY));
 		}
+		/* the member nodes are freed with fp, so drop cached lookups of them */
+		nv_uncache(NULL);
 		nv_disc(np,fp,NV_POP);
 		if(!(fp->nofree&1))
 			free(fp);
@@ -1444,7 +1446,7 @@ int	sh_outtype(Sfio_t *out)
 			if(mp->nvalue && nv_funtree(mp))
 			{
 				sfputc(out, '\n');
-				sh_deparse(out, (Shnode_t*)(nv_funtree(mp)), 2 | nv_isattr(mp,NV_FPOSIX), 1);
+				sh_deparse(out, sh_tlazy((Shnode_t*)nv_funtree(mp)), 2 | nv_isattr(mp,NV_FPOSIX), 1);
 				if(nv_isattr(mp,NV_STATICF|NV_TAGGED))
 				{
 					struct Ufunction *rp = mp->nvalue;
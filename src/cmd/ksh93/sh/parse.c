@@ -37,6 +37,13 @@
 #include	"test.h"
 #include	"history.h"
 #include	"version.h"
+#include	<assert.h>
+
+#ifdef static_assert
+/* redirections of simple and compound commands are reached through t->tre.treio */
+static_assert(offsetof(struct trenod,treio)==offsetof(struct comnod,comio),"treio must overlay comio");
+static_assert(offsetof(struct trenod,treio)==offsetof(struct forknod,forkio),"treio must overlay forkio");
+#endif
 
 #define HERE_MEM	SFIO_BUFSIZE	/* size of here-docs kept in memory */
 
@@ -341,6 +348,31 @@ static const char *paramsub(const char *str)
 	return NULL;
 }
 
+/*
+ * return ARG_SIMPLEVAR if command argument ap is nothing but "$name" or
+ * "${name}", so that arg_expand() need not scan it again on each expansion;
+ * assignments never get here, so sharing the bit with ARG_APPEND is safe
+ */
+static int simplevar(struct argnod *ap)
+{
+	const char *cp = ap->argval;
+	int brace = 0;
+	if(ap->argflag&(ARG_RAW|ARG_MESSAGE|ARG_ASSIGN))
+		return 0;
+	if(*cp++!='"' || *cp++!='$')
+		return 0;
+	if(*cp=='{')
+		brace = *cp++;
+	if(!isaletter(*cp))
+		return 0;
+	do
+		cp++;
+	while(isaname(*cp));
+	if(brace && *cp++!='}')
+		return 0;
+	return (*cp++=='"' && *cp==0) ? ARG_SIMPLEVAR : 0;
+}
+
 static Shnode_t *getanode(Lex_t *lp, struct argnod *ap)
 {
 	Shnode_t *t = getnode(arithnod);
@@ -1504,6 +1536,8 @@ static Shnode_t *simple(Lex_t *lexp,int flag, struct ionod *io)
 			}
 			if((flag&NV_COMVAR) && !assignment)
 				sh_syntax(lexp,0);
+			if(!(flag&SH_ASSIGN))
+				argp->argflag |= simplevar(argp);
 			*argtail = argp;
 			argtail = &(argp->argnxt.ap);
 			if(!(lexp->assignok=key_on)  && !(flag&SH_NOIO) && sh_isoption(SH_NOEXEC))
@@ -1994,6 +2028,7 @@ static Shnode_t *test_primary(Lex_t *lexp)
 		t->lst.lstlef = (Shnode_t*)arg;
 		t->lst.lstrit = (Shnode_t*)lexp->arg;
 		t->tst.tstline =  sh.inlineno;
+		t->tst.tstpat = NULL;
 #if SHOPT_KIA
 		if(kia.file && (num==TEST_EF||num==TEST_NT||num==TEST_OT))
 		{
@@ -33,6 +33,7 @@
 #include	"jobs.h"
 #include	"history.h"
 #include	"test.h"
+#include	"shnodes.h"
 #include	"FEATURE/dynamic"
 
 #define RW_ALL	(S_IRUSR|S_IRGRP|S_IROTH|S_IWUSR|S_IWGRP|S_IWOTH)
@@ -580,6 +581,7 @@ static void funload(int fno, const char *name)
 	sh.funload = 1;
 	sh.inlineno = 1;
 	error_info.line = 0;
+	sh_tcacheopen(fno,pname);
 	sh_eval(sfnew(NULL,buff,IOBSIZE,fno,SFIO_READ),SH_FUNEVAL);
 	sh_close(fno);
 	sh.readscript = 0;
@@ -974,6 +976,7 @@ noreturn void path_exec(const char *arg0,char *argv[],struct argnod *local)
 		pp=path_get(arg0);
 	sh.path_err= ENOENT;
 	sfsync(NULL);
+	hist_auditsync(sh.hist_ptr,1);
 	sh_timerdel(NULL);
 	/* find first path that has a library component */
 	while(pp && (pp->flags&PATH_SKIP))
@@ -1828,6 +1831,56 @@ void path_settrackedalias(const char *name, Pathcomp_t *pp)
 		_nv_unset(np,0);
 }
 
+/*
+ * if SHPREFETCH is set, look in the buffered text of the script <iop> for
+ * lines that run . or source on a literal pathname containing a /, and ask
+ * the system to start reading those files while this script runs
+ * this is only a hint, so it does no harm if such a line is not a command
+ */
+void path_prefetch(Sfio_t *iop)
+{
+	Namval_t	*np;
+	char		*cp, *ep, *sp;
+	char		path[PATH_MAX];
+	struct stat	statb;
+	ssize_t		n;
+	int		fd;
+	if(!(np = nv_search("SHPREFETCH",sh.var_tree,0)) || !(cp = nv_getval(np)) || !*cp)
+		return;
+	if(!(cp = sfreserve(iop,0,0)) || (n = sfvalue(iop)) <= 0)
+		return;
+	for(ep=cp+n; cp; cp=memchr(cp,'\n',ep-cp))
+	{
+		while(cp<ep && (*cp=='\n' || *cp==' ' || *cp=='\t'))
+			cp++;
+		if(ep-cp>2 && cp[0]=='.' && (cp[1]==' ' || cp[1]=='\t'))
+			cp += 2;
+		else if(ep-cp>7 && memcmp(cp,"source",6)==0 && (cp[6]==' ' || cp[6]=='\t'))
+			cp += 7;
+		else
+			continue;
+		while(cp<ep && (*cp==' ' || *cp=='\t'))
+			cp++;
+		/* only words that need no expansion or quote removal */
+		for(sp=cp; cp<ep && (isalnum((unsigned char)*cp) || (*cp && strchr("/._-+,:@%",*cp))); cp++)
+			;
+		if(cp==ep || !strchr(" \t\n;&|",*cp) || (n = cp-sp) >= PATH_MAX || !memchr(sp,'/',n))
+			continue;
+		memcpy(path,sp,n);
+		path[n] = 0;
+		/* never open a device or FIFO just to give a hint */
+		if(stat(path,&statb) < 0 || !S_ISREG(statb.st_mode))
+			continue;
+		if((fd = open(path,O_RDONLY|O_NONBLOCK|O_cloexec)) >= 0)
+		{
+#if _lib_posix_fadvise && defined(POSIX_FADV_WILLNEED)
+			posix_fadvise(fd,0,0,POSIX_FADV_WILLNEED);
+#endif
+			close(fd);
+		}
+	}
+}
+
 /*
  * return a valid tracked alias if one exists and should currently be used
  */
@@ -61,6 +61,67 @@ const Shtable_t *sh_locate(const char *sp,const Shtable_t *table,int size)
 	return &empty;
 }
 
+/*
+ *  Hashed table lookup routine
+ *  The first lookup in <table> builds an open-addressing index for it,
+ *  so that most lookups compare <sp> with a single table entry.
+ *  This is used for the tables that the lexer searches for every word.
+ *  Tables that do not fit are searched with sh_locate().
+ */
+
+#define HASHSLOTS	64
+#define HASHTABLES	4
+
+static int hashname(const char *name, size_t n)
+{
+	const unsigned char *cp = (const unsigned char*)name;
+	return (cp[0] + (cp[1]<<3) + cp[n-1]*3 + n) & (HASHSLOTS-1);
+}
+
+const Shtable_t *sh_hlocate(const char *sp,const Shtable_t *table,int size)
+{
+	static struct
+	{
+		const Shtable_t	*table;
+		char		large;			/* too many entries to index */
+		unsigned char	slot[HASHSLOTS];	/* entry index+1, or 0 if free */
+	}			index[HASHTABLES];
+	static const Shtable_t	empty = {0,0};
+	const Shtable_t		*tp;
+	const char		*cp;
+	int			i, n, h;
+	if(sp==0 || *sp==0)
+		return &empty;
+	for(i=0; i < HASHTABLES && index[i].table!=table; i++)
+	{
+		if(index[i].table)
+			continue;
+		/* first lookup: index the table */
+		for(tp=table,n=0; *tp->sh_name; tp=(Shtable_t*)((char*)tp+size),n++)
+			;
+		index[i].table = table;
+		index[i].large = n >= HASHSLOTS;
+		if(index[i].large)
+			break;
+		for(tp=table,n=1; (cp = tp->sh_name) && *cp; tp=(Shtable_t*)((char*)tp+size),n++)
+		{
+			for(h=hashname(cp,strlen(cp)); index[i].slot[h]; h=(h+1)&(HASHSLOTS-1))
+				;
+			index[i].slot[h] = n;
+		}
+		break;
+	}
+	if(i >= HASHTABLES || index[i].large)
+		return sh_locate(sp,table,size);
+	for(h=hashname(sp,strlen(sp)); n=index[i].slot[h]; h=(h+1)&(HASHSLOTS-1))
+	{
+		tp = (Shtable_t*)((char*)table+(n-1)*size);
+		if(*tp->sh_name==*sp && strcmp(sp,tp->sh_name)==0)
+			return tp;
+	}
+	return &empty;
+}
+
 /*
  *  shtab_options lookup routine
  *
@@ -47,6 +47,7 @@
 struct Link
 {
 	struct Link	*next;
+	struct Link	*prev;
 	Namval_t	*child;
 	Dt_t		*dict;
 	Namval_t	*node;
@@ -60,6 +61,9 @@ static struct subshell
 	struct subshell	*prev;	/* previous subshell data */
 	struct subshell	*pipe;	/* subshell where output goes to pipe on fork */
 	struct Link	*svar;	/* save shell variable table */
+	struct Link	**svhash; /* hash index into svar, keyed by node address */
+	unsigned int	svsize;	/* number of slots in svhash; 0 or power of 2 */
+	unsigned int	svcount; /* number of links in svhash */
 	Dt_t		*sfun;	/* function scope for subshell */
 	Dt_t		*strack;/* tracked alias scope for subshell */
 	Pathcomp_t	*pathlist; /* for PATH variable */
@@ -192,29 +196,98 @@ void sh_subfork(void)
 	}
 }
 
+/*
+ * The list of variables saved by a virtual subshell can grow very long, e.g.
+ * when a loop assigns to many distinct variables. To avoid a linear search of
+ * sp->svar on every assignment, it is indexed by an open addressing hash table
+ * keyed by the address of the parent shell's node.
+ */
+#define SVHASH_MIN	32
+
+static unsigned int svhash(struct subshell *sp, Namval_t *np)
+{
+	uintptr_t	h = (uintptr_t)np >> 4;
+	h ^= h >> 16;
+	h *= 0x9E3779B1;
+	return (unsigned int)(h ^ (h >> 16)) & (sp->svsize - 1);
+}
+
+/*
+ * Return the slot for node <np>; if it is not saved, the slot is empty.
+ */
+static struct Link **svslot(struct subshell *sp, Namval_t *np)
+{
+	unsigned int	i = svhash(sp,np);
+	while(sp->svhash[i] && sp->svhash[i]->node!=np)
+		i = (i+1) & (sp->svsize-1);
+	return &sp->svhash[i];
+}
+
+static struct Link *svfind(struct subshell *sp, Namval_t *np)
+{
+	return sp->svsize ? *svslot(sp,np) : NULL;
+}
+
+static void svinsert(struct subshell *sp, struct Link *lp)
+{
+	if(2*(sp->svcount+1) > sp->svsize)
+	{
+		struct Link	**old = sp->svhash;
+		unsigned int	i, oldsize = sp->svsize;
+		sp->svsize = oldsize ? 2*oldsize : SVHASH_MIN;
+		sp->svhash = sh_newof(0,struct Link*,sp->svsize,0);
+		for(i=0; i < oldsize; i++)
+			if(old[i])
+				*svslot(sp,old[i]->node) = old[i];
+		free(old);
+	}
+	*svslot(sp,lp->node) = lp;
+	sp->svcount++;
+}
+
+/*
+ * Delete link <lp> from the index, moving back any entries in the same
+ * probe sequence so that no tombstones are needed.
+ */
+static void svdelete(struct subshell *sp, struct Link *lp)
+{
+	unsigned int	i, j, k, mask = sp->svsize-1;
+	i = (unsigned int)(svslot(sp,lp->node) - sp->svhash);
+	sp->svhash[i] = 0;
+	sp->svcount--;
+	for(j=(i+1)&mask; sp->svhash[j]; j=(j+1)&mask)
+	{
+		k = svhash(sp,sp->svhash[j]->node);
+		if((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j)))
+		{
+			sp->svhash[i] = sp->svhash[j];
+			sp->svhash[j] = 0;
+			i = j;
+		}
+	}
+}
+
 int nv_subsaved(Namval_t *np, int flags)
 {
 	struct subshell	*sp;
-	struct Link		*lp, *lpprev;
+	struct Link		*lp;
 	for(sp = (struct subshell*)subshell_data; sp; sp=sp->prev)
 	{
-		lpprev = 0;
-		for(lp=sp->svar; lp; lpprev=lp, lp=lp->next)
+		if(!(lp = svfind(sp,np)))
+			continue;
+		if(flags&NV_TABLE)
 		{
-			if(lp->node==np)
-			{
-				if(flags&NV_TABLE)
-				{
-					if(lpprev)
-						lpprev->next = lp->next;
-					else
-						sp->svar = lp->next;
-					free(np);
-					free(lp);
-				}
-				return 1;
-			}
+			if(lp->prev)
+				lp->prev->next = lp->next;
+			else
+				sp->svar = lp->next;
+			if(lp->next)
+				lp->next->prev = lp->prev;
+			svdelete(sp,lp);
+			free(np);
+			free(lp);
 		}
+		return 1;
 	}
 	return 0;
 }
@@ -267,14 +340,11 @@ void sh_assignok(Namval_t *np,int add)
 		if(!add || array_assoc(ap))
 			return;
 	}
-	for(lp=sp->svar; lp;lp = lp->next)
-	{
-		if(lp->node==np)
-			return;
-	}
+	if(svfind(sp,np))
+		return;
 	/* first two pointers use linkage from np */
-	lp = (struct Link*)sh_malloc(sizeof(*np)+2*sizeof(void*));
-	memset(lp,0, sizeof(*mp)+2*sizeof(void*));
+	lp = (struct Link*)sh_malloc(sizeof(*np)+3*sizeof(void*));
+	memset(lp,0, sizeof(*mp)+3*sizeof(void*));
 	lp->node = np;
 	if(!add &&  nv_isvtree(np))
 	{
@@ -298,8 +368,11 @@ void sh_assignok(Namval_t *np,int add)
 	}
 	lp->dict = dp;
 	mp = (Namval_t*)&lp->dict;
-	lp->next = subshell_data->svar;
-	subshell_data->svar = lp;
+	lp->next = sp->svar;
+	if(sp->svar)
+		sp->svar->prev = lp;
+	sp->svar = lp;
+	svinsert(sp,lp);
 	save = sh.subshell;
 	sh.subshell = 0;
 	mp->nvname = np->nvname;
@@ -314,10 +387,12 @@ void sh_assignok(Namval_t *np,int add)
 
 /*
  * restore the variables
+ * Restored links stay in the index until it is freed as a whole, with their
+ * node cleared so that nv_subsaved() no longer finds them.
  */
 static void nv_restore(struct subshell *sp)
 {
-	struct Link	*lp, *lq;
+	struct Link	*lp, *lq, *done = 0;
 	Namval_t	*mp, *np;
 	Namval_t	*mpnext;
 	int		flags,nofree;
@@ -376,9 +451,20 @@ static void nv_restore(struct subshell *sp)
 			mpnext = *((Namval_t**)mp);
 			dtinsert(lp->dict,mp);
 		}
+		lp->node = 0;
+		lp->next = done;
+		done = lp;
+		if(sp->svar = lq)
+			lq->prev = 0;
+	}
+	for(lp=done; lp; lp=lq)
+	{
+		lq = lp->next;
 		free(lp);
-		sp->svar = lq;
 	}
+	free(sp->svhash);
+	sp->svhash = 0;
+	sp->svsize = sp->svcount = 0;
 	sh.nv_restore = 0;
 }
 
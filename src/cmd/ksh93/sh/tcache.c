@@ -0,0 +1,226 @@
+/***********************************************************************
+*                                                                      *
+*              This file is part of the ksh 93u+m package              *
+*             Copyright (c) 2026 Contributors to ksh 93u+m             *
+*                      and is licensed under the                       *
+*                 Eclipse Public License, Version 2.0                  *
+*                                                                      *
+*                A copy of the License is available at                 *
+*      https://www.eclipse.org/org/documents/epl-2.0/EPL-2.0.html      *
+*         (with md5 checksum 84283fa8859daf213bdda5a9f8d1be1d)         *
+*                                                                      *
+***********************************************************************/
+/*
+ * cache of compiled shell scripts
+ *
+ * If SHCOMP_CACHE names a directory, the parse trees of scripts, dot
+ * scripts and autoloaded function files are written there in shcomp(1)
+ * format as they are parsed. The next time the same file is read, the
+ * shell reads the compiled trees instead, as long as the file's device,
+ * inode, size and modification time, the shell version, the options that
+ * affect parsing and the aliases defined when it is opened are unchanged.
+ * A file whose parse expands an alias is not cached, as the result depends
+ * on aliases defined while it runs.
+ */
+
+#include	"shopt.h"
+#include	"defs.h"
+#include	<ls.h>
+#include	<tv.h>
+#include	"shnodes.h"
+#include	"path.h"
+#include	"io.h"
+#include	"version.h"
+
+#define CNTL(x)	((x)&037)
+
+typedef struct Tcache_s
+{
+	struct Tcache_s	*next;
+	Sfio_t		*out;		/* compiled trees being written */
+	char		*name;		/* cache file name */
+	char		*tmp;		/* temporary file name */
+	int		fd;		/* source file descriptor */
+	pid_t		pid;		/* process writing the cache */
+} Tcache_t;
+
+static const char header[6] = { CNTL('k'),CNTL('s'),CNTL('h'),0,SHCOMP_HDR_VERSION,0 };
+static Tcache_t *tclist;
+
+/*
+ * remove writer <tp> from the list and install its file if <commit> is set
+ */
+static void tc_close(Tcache_t *tp, int commit)
+{
+	Tcache_t *pp;
+	if(tp==tclist)
+		tclist = tp->next;
+	else
+	{
+		for(pp=tclist; pp->next!=tp; pp=pp->next);
+		pp->next = tp->next;
+	}
+	if(sfclose(tp->out) < 0 || !commit || rename(tp->tmp,tp->name) < 0)
+		unlink(tp->tmp);
+	free(tp->name);
+	free(tp->tmp);
+	free(tp);
+}
+
+/*
+ * return a hash of the alias table
+ */
+static unsigned int aliashash(void)
+{
+	Namval_t	*np;
+	char		*cp;
+	unsigned int	h = 0;
+	for(np=(Namval_t*)dtfirst(sh.alias_tree); np; np=(Namval_t*)dtnext(sh.alias_tree,np))
+		if(cp = nv_getval(np))
+			h = h*31 + (strhash(nv_name(np)) ^ strhash(cp)*3);
+	return h;
+}
+
+/*
+ * called when the file <path> has been opened on <fd> for reading commands
+ * on a cache hit, <fd> is made to read the compiled trees instead
+ * otherwise, a cache file is started that sh_tcachetree() fills in
+ */
+void sh_tcacheopen(int fd, const char *path)
+{
+	Namval_t	*np;
+	Tcache_t	*tp;
+	struct stat	statb;
+	Tv_t		tv;
+	Sfio_t		*out;
+	char		*dir, *key, *name, *buff;
+	size_t		len;
+	int		cfd, n;
+	if(!path || *path!='/' || !(np = nv_search("SHCOMP_CACHE",sh.var_tree,0)) || !(dir = nv_getval(np)) || !*dir)
+		return;
+	/* these need the source text */
+	if(sh_isoption(SH_VERBOSE) || sh_isoption(SH_NOEXEC))
+		return;
+	/* only use a directory that nobody else can write to */
+	if(stat(dir,&statb) < 0 || !S_ISDIR(statb.st_mode) || statb.st_uid!=sh.euserid || (statb.st_mode&(S_IWGRP|S_IWOTH)))
+		return;
+	if(fstat(fd,&statb) < 0 || !S_ISREG(statb.st_mode))
+		return;
+	tvgetmtime(&tv,&statb);
+	key = sh_strdup(sfprints("%s\n%ju %ju %jd %ju.%09lu\n%s\n%d%d%d%d %x\n",e_version+1,
+		(Sfulong_t)statb.st_dev,(Sfulong_t)statb.st_ino,(Sflong_t)statb.st_size,
+		(Sfulong_t)tv.tv_sec,(unsigned long)tv.tv_nsec,path,
+		!!sh_isoption(SH_POSIX),!!sh_isoption(SH_BRACEEXPAND),!!sh_isoption(SH_KEYWORD),!!sh_isoption(SH_RESTRICTED),
+		aliashash()));
+	len = strlen(key);
+	name = sh_strdup(sfprints("%s/%08x.shc",dir,strhash(path)));
+	if((cfd = sh_open(name,O_RDONLY|O_cloexec)) >= 0)
+	{
+		/* only trust a cache file that nobody else could have written */
+		n = fstat(cfd,&statb) >= 0 && statb.st_uid==sh.euserid && !(statb.st_mode&(S_IWGRP|S_IWOTH));
+		buff = sh_malloc(len);
+		if(n && read(cfd,buff,len)==len && memcmp(buff,key,len)==0)
+		{
+			/* the descriptor now reads the compiled trees after the key */
+			n = fcntl(fd,F_GETFD,0);
+			if(dup2(cfd,fd) >= 0 && n > 0)
+				fcntl(fd,F_SETFD,n);
+			n = -1;
+		}
+		free(buff);
+		sh_close(cfd);
+		if(n < 0)
+		{
+			free(key);
+			free(name);
+			return;
+		}
+	}
+	tp = sh_newof(0,Tcache_t,1,0);
+	tp->tmp = sh_strdup(sfprints("%s.%d",name,(int)sh.current_pid));
+	/* O_EXCL does not follow a symbolic link; a leftover file of a dead shell with our pid is ours */
+	unlink(tp->tmp);
+	if((cfd = sh_open(tp->tmp,O_WRONLY|O_CREAT|O_EXCL|O_cloexec,S_IRUSR|S_IWUSR)) >= 0 && cfd < 10)
+	{
+		if((n = sh_fcntl(cfd,F_dupfd_cloexec,10)) >= 0)
+		{
+			sh_close(cfd);
+			cfd = n;
+		}
+	}
+	if(cfd < 0 || !(out = sfnew(NULL,NULL,-1,cfd,SFIO_WRITE)))
+	{
+		if(cfd >= 0)
+		{
+			sh_close(cfd);
+			unlink(tp->tmp);
+		}
+		free(tp->tmp);
+		free(tp);
+		free(key);
+		free(name);
+		return;
+	}
+	sfwrite(out,key,len);
+	sfwrite(out,header,sizeof(header));
+	free(key);
+	tp->out = out;
+	tp->name = name;
+	tp->fd = fd;
+	tp->pid = sh.current_pid;
+	tp->next = tclist;
+	tclist = tp;
+}
+
+/*
+ * add the tree <t> just parsed from <iop> to its cache file, if any
+ * the file is installed when the end of input is reached
+ */
+void sh_tcachetree(Sfio_t *iop, const Shnode_t *t)
+{
+	Tcache_t	*tp;
+	Namval_t	*np;
+	char		*cp;
+	int		fd = sffileno(iop), done = 0;
+	for(tp=tclist; tp; tp=tp->next)
+		if(tp->fd==fd && tp->pid==sh.current_pid)
+			break;
+	if(!tp)
+		return;
+	if(t && sh_tdump(tp->out,t) < 0)
+	{
+		tc_close(tp,0);
+		return;
+	}
+	/* like shcomp, stop at a top level exit or exec and keep the rest as text */
+	if(t && (t->tre.tretyp&COMMSK)==TCOM && (np=t->com.comnamp) && (cp=nv_name(np)))
+	{
+		if(strcmp(cp,"exit")==0)
+			done = 1;
+		else if(strcmp(cp,"exec")==0)
+		{
+			if(t->com.comtyp&COMSCAN)
+				done = t->com.comarg.ap->argnxt.ap!=0;
+			else
+				done = t->com.comarg.dp->dolnum > 1;
+		}
+		if(done && !sfeof(iop))
+			sfmove(iop,tp->out,SFIO_UNBOUND,-1);
+	}
+	if(done || !sfreserve(iop,0,0))
+		tc_close(tp,!sferror(iop));
+}
+
+/*
+ * discard the unfinished cache file for <fd>, or all of them if <fd> is -1
+ */
+void sh_tcachedone(int fd)
+{
+	Tcache_t *tp, *tpnext;
+	for(tp=tclist; tp; tp=tpnext)
+	{
+		tpnext = tp->next;
+		if((fd<0 || tp->fd==fd) && tp->pid==sh.current_pid)
+			tc_close(tp,0);
+	}
+}
@@ -118,7 +118,7 @@ static int p_tree(const Shnode_t *t)
 				return -1;
 			if(p_string(t->funct.functnam)<0)
 				return -1;
-			if(p_tree(t->funct.functtre)<0)
+			if(p_tree(sh_tlazy(t->funct.functtre))<0)
 				return -1;
 			return p_tree((Shnode_t*)t->funct.functargs);
 		case TTST:
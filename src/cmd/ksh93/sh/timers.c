@@ -31,6 +31,7 @@ typedef struct _timer
 	struct _timer	*next;
 	void 		(*action)(void*);
 	void		*handle;
+	int		index;		/* position in heap, -1 if not pending */
 } Timer_t;
 
 #define IN_ADDTIMEOUT	1
@@ -38,15 +39,27 @@ typedef struct _timer
 #define DEFER_SIGALRM	4
 #define SIGALRM_CALL	8
 
-static Timer_t *tptop, *tpmin, *tpfree;
+/*
+ * pending timers are kept in a binary min-heap ordered by wakeup time
+ * timers that expired or were deleted go on the dead list and are
+ * only recycled on the next alarm, as callers may still hold them
+ */
+static Timer_t **heap, *tpdead, *tpfree;
+static int nheap, maxheap;
 static char time_state;
 
 static Sfdouble_t getnow(void)
 {
 	Sfdouble_t now;
+#if _lib_clock_gettime && defined(CLOCK_MONOTONIC)
+	struct timespec tp;
+	clock_gettime(CLOCK_MONOTONIC,&tp);
+	now = tp.tv_sec + 1.e-9*tp.tv_nsec;
+#else
 	struct timeval tp;
 	timeofday(&tp);
 	now = tp.tv_sec + 1.e-6*tp.tv_usec;
+#endif
 	return now+.001;
 }
 
@@ -78,11 +91,72 @@ static Sfdouble_t setalarm(Sfdouble_t t)
 	return t;
 }
 
+/*
+ * move heap entry <i> towards the root until its parent wakes up no later
+ */
+static void heapup(int i)
+{
+	Timer_t *tp = heap[i];
+	int parent;
+	while(i>0 && heap[parent=(i-1)/2]->wakeup > tp->wakeup)
+	{
+		heap[i] = heap[parent];
+		heap[i]->index = i;
+		i = parent;
+	}
+	heap[i] = tp;
+	tp->index = i;
+}
+
+/*
+ * move heap entry <i> towards the leaves until no child wakes up earlier
+ */
+static void heapdown(int i)
+{
+	Timer_t *tp = heap[i];
+	int child;
+	while((child=2*i+1) < nheap)
+	{
+		if(child+1<nheap && heap[child+1]->wakeup < heap[child]->wakeup)
+			child++;
+		if(heap[child]->wakeup >= tp->wakeup)
+			break;
+		heap[i] = heap[child];
+		heap[i]->index = i;
+		i = child;
+	}
+	heap[i] = tp;
+	tp->index = i;
+}
+
+/*
+ * remove <tp> from the heap and put it on the dead list
+ */
+static void heapdel(Timer_t *tp)
+{
+	Timer_t *last = heap[--nheap];
+	int i = tp->index;
+	tp->index = -1;
+	tp->action = 0;
+	tp->next = tpdead;
+	tpdead = tp;
+	if(last==tp)
+		return;
+	heap[i] = last;
+	last->index = i;
+	if(i>0 && heap[(i-1)/2]->wakeup > last->wakeup)
+		heapup(i);
+	else
+		heapdown(i);
+}
+
 /* signal handler for alarm call */
 static void sigalrm(int sig)
 {
-	Timer_t *tp, *tplast, *tpold, *tpnext;
+	Timer_t *tp;
 	Sfdouble_t now;
+	void (*action)(void*);
+	void *handle;
 	static Sfdouble_t left;
 	NOT_USED(sig);
 	left = 0;
@@ -92,8 +166,8 @@ static void sigalrm(int sig)
 		kill(sh.current_pid,SIGALRM|SH_TRAP);
 	if(time_state)
 	{
-		if(time_state&IN_ADDTIMEOUT)
-			time_state |= DEFER_SIGALRM;
+		/* the timer code that was interrupted handles this when done */
+		time_state |= DEFER_SIGALRM;
 		errno = EINTR;
 		return;
 	}
@@ -101,68 +175,63 @@ static void sigalrm(int sig)
 	sigrelease(SIGALRM);
 	while(1)
 	{
+		if(time_state&DEFER_SIGALRM)
+		{
+			/* the alarm went off between actions, so it must be set again */
+			time_state &= ~DEFER_SIGALRM;
+			left = 0;
+		}
+		while(tp=tpdead)
+		{
+			tpdead = tp->next;
+			tp->next = tpfree;
+			tpfree = tp;
+		}
 		now = getnow();
-		tpold = tpmin = 0;
-		for(tplast=0,tp=tptop; tp; tp=tpnext)
+		action = 0;
+		handle = 0;
+		if(nheap && (tp=heap[0])->wakeup <= now)
 		{
-			tpnext = tp->next;
-			if(tp->action)
+			action = tp->action;
+			handle = tp->handle;
+			if(tp->incr)
 			{
-				if(tp->wakeup <=now)
-				{
-					if(!tpold || tpold->wakeup>tp->wakeup)
-						tpold = tp;
-				}
-				else
-				{
-					if(!tpmin || tpmin->wakeup>tp->wakeup)
-						tpmin=tp;
-				}
-				tplast = tp;
+				while((tp->wakeup += tp->incr) <= now);
+				heapdown(0);
 			}
 			else
-			{
-				if(tplast)
-					tplast->next = tp->next;
-				else
-					tptop = tp->next;
-				tp->next = tpfree;
-				tpfree = tp;
-			}
-		}
-		if((tp=tpold) && tp->incr)
-		{
-			while((tp->wakeup += tp->incr) <= now);
-			if(!tpmin || tpmin->wakeup>tp->wakeup)
-				tpmin=tp;
+				heapdel(tp);
 		}
-		if(tpmin && (left==0 || (tp && tpmin->wakeup < (now+left))))
+		if(nheap && (left==0 || (action && heap[0]->wakeup < (now+left))))
 		{
+			tp = heap[0];
 			if(left==0)
 				signal(SIGALRM,sigalrm);
-			left = setalarm(tpmin->wakeup-now);
-			if(left && (now+left) < tpmin->wakeup)
+			left = setalarm(tp->wakeup-now);
+			if(left && (now+left) < tp->wakeup)
 				setalarm(left);
 			else
-				left=tpmin->wakeup-now;
+				left=tp->wakeup-now;
 		}
-		if(tp)
+		if(!action)
 		{
-			void	(*action)(void*);
-			action = tp->action;
-			if(!tp->incr)
-				tp->action = 0;
-			errno = EINTR;
-			time_state &= ~IN_SIGALRM;
-			(*action)(tp->handle);
-			time_state |= IN_SIGALRM;
-		}
-		else
+			if(time_state&DEFER_SIGALRM)
+				continue;
 			break;
+		}
+		errno = EINTR;
+		time_state &= ~IN_SIGALRM;
+		(*action)(handle);
+		time_state |= IN_SIGALRM;
 	}
-	if(!tpmin)
+	if(!nheap)
 		signal(SIGALRM,(sh.sigflag[SIGALRM]&SH_SIGFAULT)?sh_fault:SIG_DFL);
 	time_state &= ~IN_SIGALRM;
+	if(time_state&DEFER_SIGALRM)
+	{
+		time_state = SIGALRM_CALL;
+		sigalrm(SIGALRM);
+	}
 	errno = EINTR;
 }
 
@@ -189,12 +258,17 @@ void *sh_timeradd(Sfulong_t msec,int flags,void (*action)(void*),void *handle)
 	tp->incr = (flags?t:0);
 	tp->action = action;
 	tp->handle = handle;
+	tp->next = 0;
 	time_state |= IN_ADDTIMEOUT;
-	tp->next = tptop;
-	tptop = tp;
-	if(!tpmin || tp->wakeup < tpmin->wakeup)
+	if(nheap >= maxheap)
+	{
+		maxheap = maxheap ? 2*maxheap : 16;
+		heap = (Timer_t**)sh_realloc(heap,maxheap*sizeof(Timer_t*));
+	}
+	heap[nheap++] = tp;
+	heapup(nheap-1);
+	if(tp->index==0)
 	{
-		tpmin = tp;
 		fn = (Handler_t)signal(SIGALRM,sigalrm);
 		if((t= setalarm(t))>0 && fn  && fn!=(Handler_t)sigalrm)
 		{
@@ -202,16 +276,13 @@ void *sh_timeradd(Sfulong_t msec,int flags,void (*action)(void*),void *handle)
 			*hp = fn;
 			sh_timeradd((Sflong_t)(1000*t), 0, oldalrm, hp);
 		}
-		tp = tptop;
 	}
-	else if(tpmin && !tpmin->action)
-		time_state |= DEFER_SIGALRM;
 	time_state &= ~IN_ADDTIMEOUT;
 	if(time_state&DEFER_SIGALRM)
 	{
 		time_state=SIGALRM_CALL;
 		sigalrm(SIGALRM);
-		if(tp!=tptop)
+		if(tp->index<0)
 			tp=0;
 	}
 	return tp;
@@ -224,16 +295,28 @@ void	sh_timerdel(void *handle)
 {
 	Timer_t *tp = (Timer_t*)handle;
 	if(tp)
-		tp->action = 0;
+	{
+		if(tp->index<0)
+			return;
+		time_state |= IN_ADDTIMEOUT;
+		heapdel(tp);
+		time_state &= ~IN_ADDTIMEOUT;
+		if(time_state&DEFER_SIGALRM)
+		{
+			time_state=SIGALRM_CALL;
+			sigalrm(SIGALRM);
+		}
+	}
 	else
 	{
-		for(tp=tptop; tp; tp=tp->next)
-			tp->action = 0;
-		if(tpmin)
+		time_state |= IN_ADDTIMEOUT;
+		if(nheap)
 		{
-			tpmin = 0;
+			while(nheap)
+				heapdel(heap[nheap-1]);
 			setalarm((Sfdouble_t)0);
 		}
+		time_state &= ~(IN_ADDTIMEOUT|DEFER_SIGALRM);
 		signal(SIGALRM,(sh.sigflag[SIGALRM]&SH_SIGFAULT)?sh_fault:SIG_DFL);
 	}
 }
@@ -36,22 +36,172 @@ static struct regnod	*r_switch(void);
 static Shnode_t		*r_tree(void);
 static char		*r_string(void);
 static void		r_comarg(struct comnod*);
+static Shnode_t		*r_lazy(void);
+static void		s_tree(void);
 
 static Sfio_t *infile;
 
+/*
+ * the fields are decoded straight from the sfio buffer, which is held
+ * with sfreserve() from rbase to rend while reading; rcur is the next byte
+ * fields that straddle the end of the buffer are read with the sfio functions
+ */
+static unsigned char *rbase, *rcur, *rend;
+
+/* for stepping over function bodies; see r_lazy() */
+#define SKIP_END	1
+#define SKIP_FUN	2
+static const unsigned char *scur;
+static int sbad;
+
 #define getnode(type)   stkalloc(sh.stk,sizeof(struct type))
 
+/*
+ * give the bytes decoded so far back to the stream
+ */
+static void r_release(void)
+{
+	if(rbase)
+	{
+		sfread(infile,rbase,rcur-rbase);
+		rbase = rcur = rend = 0;
+	}
+}
+
+/*
+ * called when the buffer can't satisfy a request
+ * returns 1 if a new buffer was reserved, 0 if the sfio functions must be used
+ */
+static int r_reserve(void)
+{
+	if(rbase)
+	{
+		r_release();
+		return 0;
+	}
+	if(!(rbase = sfreserve(infile,SFIO_UNBOUND,SFIO_LOCKR)))
+		return 0;
+	rend = (rcur=rbase) + sfvalue(infile);
+	return 1;
+}
+
+/*
+ * same as sfgetu()
+ */
+static Sfulong_t r_getu(void)
+{
+	unsigned char	*cp;
+	Sfulong_t	v;
+	int		c;
+	do
+	{
+		for(v=0, cp=rcur; cp < rend;)
+		{
+			c = *cp++;
+			v = (v<<SFIO_UBITS) | (c&(SFIO_MORE-1));
+			if(!(c&SFIO_MORE))
+			{
+				rcur = cp;
+				return v;
+			}
+		}
+	}
+	while(r_reserve());
+	return sfgetu(infile);
+}
+
+/*
+ * same as sfgetl()
+ */
+static Sflong_t r_getl(void)
+{
+	unsigned char	*cp;
+	Sfulong_t	v;
+	int		c;
+	do
+	{
+		for(v=0, cp=rcur; cp < rend;)
+		{
+			c = *cp++;
+			if(c&SFIO_MORE)
+				v = (v<<SFIO_UBITS) | (c&(SFIO_MORE-1));
+			else
+			{
+				v = (v<<SFIO_SBITS) | (c&(SFIO_SIGN-1));
+				rcur = cp;
+				return (c&SFIO_SIGN) ? -(Sflong_t)v-1 : (Sflong_t)v;
+			}
+		}
+	}
+	while(r_reserve());
+	return sfgetl(infile);
+}
+
+static int r_getc(void)
+{
+	do
+		if(rcur < rend)
+			return *rcur++;
+	while(r_reserve());
+	return sfgetc(infile);
+}
+
+static ssize_t r_read(void *ptr, size_t n)
+{
+	do
+		if(rend-rcur >= n)
+		{
+			memcpy(ptr,rcur,n);
+			rcur += n;
+			return n;
+		}
+	while(r_reserve());
+	return sfread(infile,ptr,n);
+}
+
 Shnode_t *sh_trestore(Sfio_t *in)
 {
+	Shnode_t *t;
 	infile = in;
-	return r_tree();
+	t = r_tree();
+	r_release();
+	return t;
+}
+
+/*
+ * return the function body <t>, first restoring it if r_lazy() saved it
+ */
+Shnode_t *sh_tlazy(Shnode_t *t)
+{
+	struct lazynod	*lp = (struct lazynod*)t;
+	struct checkpt	buff;
+	Sfio_t		*in;
+	Stk_t		*savstak;
+	int		jmpval;
+	if(!t || t->tre.tretyp!=TLAZY)
+		return t;
+	if(!lp->lazytre && (in = sfnew(NULL,lp->lazybuf,lp->lazysize,-1,SFIO_READ|SFIO_STRING)))
+	{
+		savstak = sh.stk;
+		sh.stk = lp->lazystk;
+		sh_pushcontext(&buff,1);
+		jmpval = sigsetjmp(buff.buff,0);
+		if(jmpval==0)
+			lp->lazytre = sh_trestore(in);
+		sh_popcontext(&buff);
+		sh.stk = savstak;
+		sfclose(in);
+		if(jmpval)
+			siglongjmp(*sh.jmplist,jmpval);
+	}
+	return lp->lazytre;
 }
 /*
  * read in a shell tree
  */
 static Shnode_t *r_tree(void)
 {
-	long l = sfgetl(infile);
+	long l = r_getl();
 	int type;
 	Shnode_t *t=0;
 	if(l<0)
@@ -72,7 +222,7 @@ static Shnode_t *r_tree(void)
 		case TSETIO:
 		case TFORK:
 			t = getnode(forknod);
-			t->fork.forkline = sfgetu(infile);
+			t->fork.forkline = r_getu();
 			t->fork.forktre = r_tree();
 			t->fork.forkio = r_redirect();
 			break;
@@ -98,17 +248,21 @@ static Shnode_t *r_tree(void)
 			break;
 		case TARITH:
 			t = getnode(arithnod);
-			t->ar.arline = sfgetu(infile);
+			t->ar.arline = r_getu();
 			t->ar.arexpr = r_arg();
 			t->ar.arcomp = 0;
 			if((t->ar.arexpr)->argflag&ARG_RAW)
-				 t->ar.arcomp = sh_arithcomp((t->ar.arexpr)->argval);
+			{
+				/* the compiler can throw an error */
+				r_release();
+				t->ar.arcomp = sh_arithcomp((t->ar.arexpr)->argval);
+			}
 			break;
 		case TFOR:
 			t = getnode(fornod);
 			t->for_.forline = 0;
 			if(type&FLINENO)
-				t->for_.forline = sfgetu(infile);
+				t->for_.forline = r_getu();
 			t->for_.fortre = r_tree();
 			t->for_.fornam = r_string();
 			t->for_.forlst = (struct comnod*)r_tree();
@@ -117,7 +271,7 @@ static Shnode_t *r_tree(void)
 			t = getnode(swnod);
 			t->sw.swline = 0;
 			if(type&FLINENO)
-				t->sw.swline = sfgetu(infile);
+				t->sw.swline = r_getu();
 			t->sw.swarg = r_arg();
 			if(type&COMSCAN)
 				t->sw.swio = r_redirect();
@@ -131,7 +285,7 @@ static Shnode_t *r_tree(void)
 			struct slnod *slp;
 			struct functnod *fp;
 			t = getnode(functnod);
-			t->funct.functline = sfgetu(infile);
+			t->funct.functline = r_getu();
 			t->funct.functnam = r_string();
 			savstak = sh.stk;
 			sh.stk = stkopen(STK_SMALL);
@@ -144,7 +298,8 @@ static Shnode_t *r_tree(void)
 			fp->functtyp = TFUN|FAMP;
 			if(sh.st.filename)
 				fp->functnam = stkcopy(sh.stk,sh.st.filename);
-			t->funct.functtre = r_tree();
+			if((type&COMSCAN) || !(t->funct.functtre = r_lazy()))
+				t->funct.functtre = r_tree();
 			t->funct.functstak = slp;
 			t->funct.functargs = (struct comnod*)r_tree();
 			slp->slptr = sh.stk;
@@ -154,14 +309,17 @@ static Shnode_t *r_tree(void)
 		}
 		case TTST:
 			t = getnode(tstnod);
-			t->tst.tstline = sfgetu(infile);
+			t->tst.tstline = r_getu();
 			if((type&TPAREN)==TPAREN)
 				t->lst.lstlef = r_tree();
 			else
 			{
 				t->lst.lstlef = (Shnode_t*)r_arg();
 				if((type&TBINARY))
+				{
 					t->lst.lstrit = (Shnode_t*)r_arg();
+					t->tst.tstpat = NULL;
+				}
 			}
 	}
 	if(t)
@@ -174,7 +332,7 @@ static struct argnod *r_arg(void)
 	struct argnod	*ap=0, *apold, *aptop=0;
 	long		l;
 	Stk_t		*stkp=sh.stk;
-	while((l=sfgetu(infile))>0)
+	while((l=r_getu())>0)
 	{
 		ap = stkseek(stkp,(unsigned)l+ARGVAL);
 		if(!aptop)
@@ -182,17 +340,17 @@ static struct argnod *r_arg(void)
 		else
 			apold->argnxt.ap = ap;
 		if(--l > 0)
-			sfread(infile,ap->argval,(size_t)l);
+			r_read(ap->argval,(size_t)l);
 		ap->argval[l] = 0;
 		ap->argchn.cp = 0;
-		ap->argflag = sfgetc(infile);
+		ap->argflag = r_getc();
 		ap = stkfreeze(stkp,0);
 		if(*ap->argval==0 && (ap->argflag&ARG_EXP))
 			ap->argchn.ap = (struct argnod*)r_tree();
 		else if(*ap->argval==0 && (ap->argflag&~(ARG_APPEND|ARG_MESSAGE|ARG_QUOTED|ARG_ARRAY))==0)
 		{
 			struct fornod *fp = (struct fornod*)getnode(fornod);
-			fp->fortyp = sfgetu(infile);
+			fp->fortyp = r_getu();
 			fp->fortre = r_tree();
 			fp->fornam = ap->argval+1;
 			ap->argchn.ap = (struct argnod*)fp;
@@ -208,7 +366,7 @@ static struct ionod *r_redirect(void)
 {
 	long l;
 	struct ionod *iop=0, *iopold, *ioptop=0;
-	while((l=sfgetl(infile))>=0)
+	while((l=r_getl())>=0)
 	{
 		iop = (struct ionod*)getnode(ionod);
 		if(!ioptop)
@@ -222,7 +380,7 @@ static struct ionod *r_redirect(void)
 			iop->ioname = r_string();	/* file name, descriptor, etc. */
 		if(iop->iodelim = r_string())
 		{
-			iop->iosize = sfgetl(infile);
+			iop->iosize = r_getl();
 			if(sh.heredocs)
 				iop->iooffset = sfseek(sh.heredocs,0,SEEK_END);
 			else
@@ -230,6 +388,7 @@ static struct ionod *r_redirect(void)
 				sh.heredocs = sftmp(512);
 				iop->iooffset = 0;
 			}
+			r_release();
 			sfmove(infile,sh.heredocs, iop->iosize, -1);
 		}
 		iopold = iop;
@@ -258,7 +417,7 @@ static void r_comarg(struct comnod *com)
 	}
 	else if(com->comarg.dp = r_comlist())
 		cmdname = com->comarg.dp->dolval[ARG_SPARE];
-	com->comline = sfgetu(infile);
+	com->comline = r_getu();
 	com->comnamq = 0;
 	if(cmdname)
 	{
@@ -266,6 +425,7 @@ static void r_comarg(struct comnod *com)
 		com->comnamp = nv_search(cmdname,sh.fun_tree,0);
 		if(com->comnamp && (cp =strrchr(cmdname+1,'.')))
 		{
+			r_release();
 			*cp = 0;
 			com->comnamp = nv_open(cmdname,sh.var_tree,NV_VARNAME|NV_NOADD|NV_NOARRAY);
 			*cp = '.';
@@ -280,7 +440,7 @@ static struct dolnod *r_comlist(void)
 	struct dolnod *dol=0;
 	long l;
 	char **argv;
-	if((l=sfgetl(infile))>0)
+	if((l=r_getl())>0)
 	{
 		dol = stkalloc(sh.stk,sizeof(struct dolnod) + sizeof(char*)*(l+ARG_SPARE));
 		dol->dolnum = l;
@@ -295,7 +455,7 @@ static struct regnod *r_switch(void)
 {
 	long l;
 	struct regnod *reg=0,*regold,*regtop=0;
-	while((l=sfgetl(infile))>=0)
+	while((l=r_getl())>=0)
 	{
 		reg = getnode(regnod);
 		if(!regtop)
@@ -314,14 +474,234 @@ static struct regnod *r_switch(void)
 
 static char *r_string(void)
 {
-	Sfio_t *in = infile;
-	unsigned long l = sfgetu(in);
+	unsigned long l = r_getu();
 	char *ptr;
 	if(l == 0)
 		return NULL;
 	ptr = stkalloc(sh.stk,(unsigned)l);
-	if(--l > 0 && sfread(in,ptr,(size_t)l) != (size_t)l)
+	if(--l > 0 && r_read(ptr,(size_t)l) != (size_t)l)
 		return NULL;
 	ptr[l] = 0;
 	return ptr;
 }
+
+/*
+ * Most functions in a library are never called. Unless the body of the
+ * function at the read position defines functions itself or does not fit
+ * in the buffer, it is copied to the function's stack as it is and
+ * restored by sh_tlazy() when it is first needed.
+ */
+static Shnode_t *r_lazy(void)
+{
+	struct lazynod	*lp;
+	size_t		n;
+	if(!rbase && !r_reserve())
+		return NULL;
+	while(1)
+	{
+		scur = rcur;
+		sbad = 0;
+		s_tree();
+		if(!sbad)
+			break;
+		/* try again with a buffer that holds more */
+		n = rend - rcur;
+		r_release();
+		if((sbad&SKIP_FUN) || !(rbase = sfreserve(infile,-(ssize_t)(n+1),SFIO_LOCKR)))
+			return NULL;
+		rend = (rcur=rbase) + sfvalue(infile);
+	}
+	n = scur - rcur;
+	lp = stkalloc(sh.stk,sizeof(struct lazynod)+n);
+	lp->lazytyp = TLAZY;
+	lp->lazytre = 0;
+	lp->lazystk = sh.stk;
+	lp->lazybuf = (char*)(lp+1);
+	lp->lazysize = n;
+	memcpy(lp->lazybuf,rcur,n);
+	rcur += n;
+	return (Shnode_t*)lp;
+}
+
+/*
+ * The s_ functions step over a tree in the buffer from scur like the r_
+ * functions read it, without building anything. They set sbad if the
+ * tree runs past the end of the buffer or defines a function.
+ */
+
+static Sfulong_t s_getu(void)
+{
+	Sfulong_t	v = 0;
+	int		c;
+	while(scur < rend)
+	{
+		c = *scur++;
+		v = (v<<SFIO_UBITS) | (c&(SFIO_MORE-1));
+		if(!(c&SFIO_MORE))
+			return v;
+	}
+	sbad |= SKIP_END;
+	return 0;
+}
+
+static Sflong_t s_getl(void)
+{
+	Sfulong_t	v = 0;
+	int		c;
+	while(scur < rend)
+	{
+		c = *scur++;
+		if(c&SFIO_MORE)
+			v = (v<<SFIO_UBITS) | (c&(SFIO_MORE-1));
+		else
+		{
+			v = (v<<SFIO_SBITS) | (c&(SFIO_SIGN-1));
+			return (c&SFIO_SIGN) ? -(Sflong_t)v-1 : (Sflong_t)v;
+		}
+	}
+	sbad |= SKIP_END;
+	return -1;
+}
+
+static int s_getc(void)
+{
+	if(scur < rend)
+		return *scur++;
+	sbad |= SKIP_END;
+	return 0;
+}
+
+static void s_skip(size_t n)
+{
+	if(rend-scur >= n)
+		scur += n;
+	else
+	{
+		scur = rend;
+		sbad |= SKIP_END;
+	}
+}
+
+static int s_string(void)
+{
+	Sfulong_t l = s_getu();
+	if(l == 0)
+		return 0;
+	s_skip(l-1);
+	return 1;
+}
+
+static void s_arg(void)
+{
+	long	l;
+	int	c, flag;
+	while((l=s_getu())>0)
+	{
+		c = (--l > 0 && scur < rend) ? *scur : 0;
+		s_skip(l);
+		flag = s_getc();
+		if(c==0 && (flag&ARG_EXP))
+			s_tree();
+		else if(c==0 && (flag&~(ARG_APPEND|ARG_MESSAGE|ARG_QUOTED|ARG_ARRAY))==0)
+		{
+			s_getu();
+			s_tree();
+		}
+	}
+}
+
+static void s_redirect(void)
+{
+	long l;
+	while((l=s_getl())>=0)
+	{
+		if((l & IOPROCSUB) && !(l & IOLSEEK))
+			s_tree();
+		else
+			s_string();
+		if(s_string())
+			s_skip(s_getl());
+		if(l&IOVNM)
+			s_string();
+	}
+}
+
+static void s_tree(void)
+{
+	long	l;
+	int	type;
+	if(sbad || (l=s_getl())<0)
+		return;
+	type = l;
+	switch(type&COMMSK)
+	{
+		case TTIME:
+		case TPAR:
+			s_tree();
+			break;
+		case TCOM:
+			s_redirect();
+			s_arg();
+			if(type&COMSCAN)
+				s_arg();
+			else if(s_getl()>0)
+				while(s_string());
+			s_getu();
+			break;
+		case TSETIO:
+		case TFORK:
+			s_getu();
+			s_tree();
+			s_redirect();
+			break;
+		case TIF:
+		case TWH:
+			s_tree();
+			s_tree();
+			s_tree();
+			break;
+		case TLST:
+		case TAND:
+		case TORF:
+		case TFIL:
+			s_tree();
+			s_tree();
+			break;
+		case TARITH:
+			s_getu();
+			s_arg();
+			break;
+		case TFOR:
+			if(type&FLINENO)
+				s_getu();
+			s_tree();
+			s_string();
+			s_tree();
+			break;
+		case TSW:
+			if(type&FLINENO)
+				s_getu();
+			s_arg();
+			if(type&COMSCAN)
+				s_redirect();
+			while(s_getl()>=0)
+			{
+				s_arg();
+				s_tree();
+			}
+			break;
+		case TFUN:
+			sbad |= SKIP_FUN;
+			break;
+		case TTST:
+			s_getu();
+			if((type&TPAREN)==TPAREN)
+				s_tree();
+			else
+			{
+				s_arg();
+				if((type&TBINARY))
+					s_arg();
+			}
+	}
+}
@@ -304,6 +304,8 @@ extern void sh_optclear(void*);
 static int sh_tclear(Shnode_t *t)
 {
 	int n=0;
+	if(t && t->tre.tretyp==TLAZY)
+		t = t->lazy.lazytre;
 	if(!t)
 		return 0;
 	switch(t->tre.tretyp&COMMSK)
@@ -565,6 +567,7 @@ int sh_eval(Sfio_t *iop, int mode)
 			errormsg(SH_DICT,ERROR_system(1),e_readscript);
 			UNREACHABLE();
 		}
+		sh_tcachetree(iop,t);
 		if(!(mode&SH_FUNEVAL) || !sfreserve(iop,0,0))
 		{
 			if(!(mode&SH_READEVAL))
@@ -593,6 +596,7 @@ int sh_eval(Sfio_t *iop, int mode)
 		sh.inlineno = lineno;
 	if(io_save)
 	{
+		sh_tcachedone(sffileno(io_save));
 		sfclose(io_save);
 		io_save = 0;
 	}
@@ -840,6 +844,31 @@ int sh_exec(const Shnode_t *t, int flags)
 			return sh.exitval;
 		}
 	}
+	/*
+	 * Optimize a literal arithmetic command '((expression))' whose expression was compiled at parse time.
+	 * This is common in loop conditions and as the increment of an arithmetic 'for' loop.
+	 */
+	else if((type&COMMSK)==TARITH && t->ar.arcomp && (t->ar.arexpr->argflag&ARG_RAW)
+	&& !sh_isoption(SH_XTRACE)
+	&& !sh.st.trap[SH_DEBUGTRAP])
+	{
+		char	*sav = stkfreeze(sh.stk,0);
+		error_info.line = t->ar.arline-sh.st.firstline;
+		sh.exitval = !arith_exec((Arith_t*)t->ar.arcomp);
+		exitset();
+		if(!(flags & ARG_OPTIMIZE))
+		{
+			if(sav != stkptr(sh.stk,0))
+				stkset(sh.stk,sav,0);
+			else if(stktell(sh.stk))
+				stkseek(sh.stk,0);
+		}
+		if(sh.trapnote)
+			sh_chktrap();
+		if(sh.trapnote&SH_SIGSET)
+			sh_exit(SH_EXITSIG|sh.lastsig);
+		return sh.exitval;
+	}
 	/* Normal command execution */
 	{
 		char		*com0 = 0;
@@ -2492,13 +2521,20 @@ int sh_exec(const Shnode_t *t, int flags)
 			else
 			{
 				int traceon=0;
+				int literal=0;
 				char *right = 0;
 				char *trap;
 				char *argv[6];
 				n = type>>TSHIFT;
 				left = sh_macpat(&(t->lst.lstlef->arg), flags & ARG_OPTIMIZE);
 				if(type&TBINARY)
-					right = sh_macpat(&(t->lst.lstrit->arg),((n==TEST_PEQ||n==TEST_PNE)?ARG_EXP:0)|(flags & ARG_OPTIMIZE));
+				{
+					struct argnod *rp = &(t->lst.lstrit->arg);
+					/* a literal pattern needs no expansion and is compiled once; see test_patmatch() */
+					if((n==TEST_PEQ||n==TEST_PNE) && (rp->argflag&(ARG_EXP|ARG_MAC|ARG_RAW))==ARG_EXP)
+						literal = 1;
+					right = literal ? rp->argval : sh_macpat(rp,((n==TEST_PEQ||n==TEST_PNE)?ARG_EXP:0)|(flags & ARG_OPTIMIZE));
+				}
 				if(trap=sh.st.trap[SH_DEBUGTRAP])
 					argv[0] = (type&TNEGATE)?((char*)e_tstbegin):"[[";
 				if(sh_isoption(SH_XTRACE))
@@ -2542,7 +2578,10 @@ int sh_exec(const Shnode_t *t, int flags)
 						argv[5] = 0;
 						sh_debug(trap,NULL,NULL,argv,pattern);
 					}
-					n = test_binop(n,left,right);
+					if(literal)
+						n = test_patmatch(left,right,&((Shnode_t*)t)->tst.tstpat)!=0 ^ (n==TEST_PNE);
+					else
+						n = test_binop(n,left,right);
 					if(traceon)
 					{
 						sfprintf(sfstderr,"%s %s ",sh_fmtq(left),op);
@@ -3029,7 +3068,7 @@ int sh_funscope(int argn, char *argv[],int(*fun)(void*),void *arg,int execflg)
 					}
 				}
 			}
-			sh_exec((Shnode_t*)(nv_funtree((fp->node))),execflg|SH_ERREXIT);
+			sh_exec(sh_tlazy((Shnode_t*)nv_funtree(fp->node)),execflg|SH_ERREXIT);
 			r = sh.exitval;
 		}
 	}
@@ -3370,9 +3409,7 @@ static pid_t sh_ntfork(const Shnode_t *t,char *argv[],int *jobid,int topfd)
 				if(stat(devfd=sfstruse(sh.strbuf),&statb)>=0)
 					argv[0] =  devfd;
 			}
-			if(!sh.shpath)
-				sh.shpath = pathshell();
-			spawnpid = path_spawn(sh.shpath,&argv[-1],arge,pp,(grp<<1)|1);
+			spawnpid = path_spawn(sh_shpath(),&argv[-1],arge,pp,(grp<<1)|1);
 			if(fd>=0)
 				close(fd);
 			argv[0] = argv[-1];
@@ -1134,5 +1134,49 @@ else	typeset -ui i
 	unset i
 fi
 
+# ======
+# Literal ((...)) commands are run by a fast path in sh_exec() unless xtrace or a DEBUG trap is on;
+# $?, traps and 'set -e' must work the same as with the full code path.
+cat > "$tmp/arithcmd.sh" <<\EOF
+typeset -i i n=0
+((1)); print "true $?"
+((0)); print "false $?"
+(((n = 1/0))) 2>/dev/null; print "error $?"
+trap 'print "ERR $?"' ERR
+((0)); ((1)); print "ERR trap done"
+trap - ERR
+set -e
+for ((i = 0; i < 3; i++)); do ((i == 1)); print "loop $i $?"; done
+function f { ((0)); print "function $?"; }
+f
+while ((n < 3)); do ((n++)); done
+print "n=$n"
+((0))
+print "end $?"
+EOF
+exp=$'true 0\nfalse 1\nerror 1\nERR trap done\nloop 0 1\nloop 1 0\nloop 2 1\nfunction 1\nn=3\nend 1'
+got=$("$SHELL" "$tmp/arithcmd.sh" 2>&1)
+[[ $got == "$exp" ]] || err_exit "((...)) status, traps or 'set -e'" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+got=$("$SHELL" -c 'trap : DEBUG; . "$1"' x "$tmp/arithcmd.sh" 2>&1)
+[[ $got == "$exp" ]] || err_exit "((...)) status, traps or 'set -e' with DEBUG trap" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+exp=$'+ i=1\n+ ((i < 2))\n+ ((i += 1))\n+ print 2\n2'
+got=$("$SHELL" -c 'PS4="+ "; set -x; i=1; ((i < 2)); ((i += 1)); print $i' 2>&1)
+[[ $got == "$exp" ]] || err_exit "((...)) with xtrace" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+exp=$'(( i < 2 ))\nprint 1\n1'
+got=$("$SHELL" -c 'i=1; trap "print -r -- \"\${.sh.command}\"" DEBUG; ((i < 2)); print $i' 2>&1)
+[[ $got == "$exp" ]] || err_exit "((...)) with DEBUG trap" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+# a signal trap must interrupt a loop made only of ((...)) commands
+exp=caught
+got=$("$SHELL" -c 'trap "print caught; exit" USR1
+	{ sleep .1; kill -s USR1 $$; } &
+	while ((SECONDS < 5)); do ((1)); done
+	print timeout' 2>&1)
+[[ $got == "$exp" ]] || err_exit "signal trap in ((...)) loop" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
@@ -1075,5 +1075,17 @@ wait "$parallel_5" || err_exit 'command substitution causes pipefail option to h
 wait "$parallel_6" || err_exit '"command | while read...done" finishing too fast'
 wait "$parallel_7" || err_exit 'early termination not causing broken pipe'
 
+# ======
+# Every reserved word is found by the hashed table lookup, including the one-character ones
+for w in '!' '[[' case do done elif else esac fi for function if in select then time until while '{' '}' namespace
+do	[[ $w == namespace ]] && ((!SHOPT_NAMESPACE)) && continue
+	got=$(whence -v "$w" 2>&1)
+	[[ $got == "$w is a keyword" ]] || err_exit "reserved word $(printf %q "$w") not recognized (got $(printf %q "$got"))"
+done
+for w in '[' '!!' fo functio '{{' ''
+do	got=$(whence -v "$w" 2>&1)
+	[[ $got == *keyword* ]] && err_exit "$(printf %q "$w") is taken for a reserved word (got $(printf %q "$got"))"
+done
+
 # ======
 exit $((Errors<125?Errors:125))
@@ -622,5 +622,79 @@ test b = b c -a "" 2>/dev/null
 (((e=$?)==2)) || err_exit "${p}[ b = b c -a \"\" ] is not an error (got status $e)"
 [[ -v p ]] && set --noposix && unset p
 
+# ======
+# Literal patterns are compiled once per test; more of them than are kept compiled must still match correctly
+for ((i=1; i<=40; i++))
+do	eval "lit$i() { [[ \$1 =~ ^x$i(.)\$ ]] && [[ \$1 != *y && \$1 == x$i@(?) ]] && print -rn -- \"\${.sh.match[1]}\"; }"
+done
+got=
+for r in a b y
+do	for ((i=1; i<=40; i++))
+	do	got+=$(lit$i "x$i$r")
+	done
+	got+=,
+done
+exp=$(printf '%040d' 0); exp="${exp//0/a},${exp//0/b},,"
+[[ $got == "$exp" ]] || err_exit "literal patterns in many tests" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+
+# ======
+# Patterns must keep matching correctly while the regcache() is resized and entries are evicted
+for n in 2 64 ''
+do	got=$(
+		SHREGEX_CACHE=$n
+		for ((i=0; i<3; i++))
+		do	for p in 1 2 3 4 5
+			do	case x$p in
+				@(y|$p)) print -n y ;;
+				x@(1|$p)) print -n $p ;;
+				esac
+				[[ ab$p == a@(b|$p)$p ]] || print -n !
+			done
+		done
+	)
+	exp=123451234512345
+	[[ $got == "$exp" ]] || err_exit "patterns with SHREGEX_CACHE=$n" \
+		"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+done
+if	[[ -v .sh.stats ]]
+then	got=$(
+		SHREGEX_CACHE=2
+		m=${.sh.stats.re_cachemisses} e=${.sh.stats.re_evictions}
+		for p in 1 2 3 1 2 3
+		do	[[ x == @(y|$p) ]]
+		done
+		print $((.sh.stats.re_cachemisses-m)) $((.sh.stats.re_evictions-e))
+	)
+	[[ $got == '6 4' ]] || err_exit "regcache() statistics in .sh.stats (expected '6 4', got $(printf %q "$got"))"
+fi
+
+# ======
+# Every test operator is found by the hashed table lookup, including the one-character ones
+: > "$tmp/op1" && ln -s op1 "$tmp/op2"
+for op in '!=' -ef -eq -ge -gt -le -lt -ne -nt -ot '<' '=' '==' '=~' '>'
+do	case $op in
+	-eq | -[gl]e)
+		set -- 1 1 ;;
+	-ne | -lt)
+		set -- 1 2 ;;
+	-gt)	set -- 2 1 ;;
+	-ef | -[no]t)
+		set -- "$tmp/op1" "$tmp/op2" ;;
+	*)	set -- b b ;;
+	esac
+	got=$(set +x; eval "[[ \$1 $op \$2 ]]" 2>&1; print $?)
+	[[ $got == [01] ]] || err_exit "[[ ... $op ... ]] not recognized (got $(printf %q "$got"))"
+	[[ $op == '=~' ]] && continue
+	got=$(set +x; test "$1" "$op" "$2" 2>&1; print $?)
+	[[ $got == [01] ]] || err_exit "test ... $op ... not recognized (got $(printf %q "$got"))"
+done
+for op in -a -o
+do	got=$(set +x; test 1 "$op" 1 2>&1; print $?)
+	[[ $got == 0 ]] || err_exit "test ... $op ... not recognized (got $(printf %q "$got"))"
+done
+got=$(set +x; eval '[[ a -xx b ]]' 2>&1; print $?)
+[[ $got == *syntax* ]] || err_exit "[[ ... -xx ... ]] is accepted (got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
@@ -1259,6 +1259,29 @@ then	got=$( { "$SHELL" -c '
 	'; } 2>&1)
 	((!(e = $?))) || err_exit 'crash with alarm and IFS' \
 		"(got status $e$( ((e>128)) && print -n /SIG && kill -l "$e"), $(printf %q "$got"))"
+
+	# many timers must all go off, in order of their expiry
+	got=$( { "$SHELL" -c '
+		builtin alarm
+		typeset -a order
+		integer i n=0 N=300
+		float t=$(printf '%(%s.%N)T' now)+.5
+		for ((i=N-1; i>=0; i--))
+		do	alarm t$i $((t + i/500.))
+			eval "function t$i.alarm { order+=($i); ((n++)); }"
+		done
+		alarm t150 +60
+		integer rc=0
+		alarm -r r +.01
+		function r.alarm { ((rc++)); }
+		SECONDS=0
+		while ((n < N-1 && SECONDS < 10)); do sleep .01; done
+		for ((i=1; i<n; i++))
+		do	((order[i] > order[i-1])) || { echo "out of order at $i"; break; }
+		done
+		echo $n $((rc >= 5)) $(alarm)
+	'; } 2>&1)
+	[[ $got == '299 1 alarm -r r +0.01 alarm t150 '* ]] || err_exit 'alarm timers lost or misordered' "(got $(printf %q "$got"))"
 fi
 
 # ======
@@ -1748,5 +1771,17 @@ got=$(set +x; { (ulimit -c 0; set --state=foo); } 2>&1)
 let "(e=$?) == 2" || err_exit "crash on unexpected option value" \
 	"(got status $e$( ((e>128)) && print -n /SIG && kill -l "$e"), $(printf %q "$got"))"
 
+# ======
+# read --async asks for read-ahead on regular files and must not change what is read
+for ((i=1; i<=5000; i++)); do print $i; done > "$tmp/async.txt"
+got=$(integer n=0 sum=0; while read --async line; do ((n++, sum+=line)); done < "$tmp/async.txt"; print $n $sum)
+exp='5000 12502500'
+[[ $got == "$exp" ]] || err_exit "'while read --async' loop" "(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+got=$(exec 3< "$tmp/async.txt"; read --async -u3 a; read -u3 b; read --async -u3 c; exec 3<&-; print $a $b $c)
+exp='1 2 3'
+[[ $got == "$exp" ]] || err_exit "read --async mixed with plain read" "(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+got=$(print foo | { read --async v; print $v; })
+[[ $got == foo ]] || err_exit "read --async from a pipe" "(expected foo, got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
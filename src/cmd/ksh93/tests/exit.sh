@@ -251,5 +251,47 @@ exp=9
 (trap 'false; exit' EXIT; exit 9)
 let "(got=$?)==exp" || err_exit "explicit exit status outside trap not honoured (got $got, expected $exp)"
 
+# ======
+# Audit records queued for a backed-up pipe must be written before the shell exits.
+# Auditing is configured in SHOPT_AUDITFILE, so this only runs if we may create that file.
+if	((!SHOPT_AUDIT))
+then	warning 'shell compiled without SHOPT_AUDIT; skipping audit test'
+elif	auditfile=$(eval "print -r -- $SHOPT_AUDITFILE"); [[ -e $auditfile || ! -w ${auditfile%/*} ]]
+then	warning "cannot create $auditfile; skipping audit test"
+else	mkfifo "$tmp/audit.fifo"
+	exec {wfd}<>"$tmp/audit.fifo"
+	# fill the pipe so that the shell cannot write its records yet
+	typeset -L4096 junk=x
+	for ((i = 0; i < 16; i++))
+	do	print -rn -- "$junk" >&$wfd
+	done
+	print -r -- "$tmp/audit.fifo;$(id -u)" > "$auditfile"
+	HISTFILE=$tmp/audit.hist ENV=/./dev/null "$SHELL" -i <<-EOF >/dev/null 2>&1 &
+		print one
+		print two
+		: > "$tmp/audit.done"
+	EOF
+	pid=$!
+	for ((i = 0; i < 100; i++))
+	do	[[ -e $tmp/audit.done ]] && break
+		sleep .05
+	done
+	rm -f "$auditfile"
+	# give it time to exit; it should be waiting for the pipe instead
+	for ((i = 0; i < 20; i++))
+	do	kill -0 "$pid" 2>/dev/null || break
+		sleep .05
+	done
+	{ sleep 10; kill "$pid"; } 2>/dev/null &
+	watchdog=$!
+	exec {rfd}<"$tmp/audit.fifo" {wfd}<&-
+	got=$(tr '\0' '\n' <&$rfd | grep -c ';  *print [ot][nw][eo]$')
+	exec {rfd}<&-
+	kill "$watchdog" 2>/dev/null
+	wait "$pid"
+	[[ $got == 2 ]] || err_exit "audit records lost at exit (expected 2, got $got)"
+	unset auditfile junk pid watchdog wfd rfd
+fi
+
 # ======
 exit $((Errors<125?Errors:125))
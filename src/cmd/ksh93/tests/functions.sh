@@ -1577,5 +1577,153 @@ do	got=$(unset -f "$b"; PATH=/dev/null; "$b" --version 2>&1)
 		"(expected status 2 and ERE match of $(printf %q "$exp"), got status $e and $(printf %q "$got"))"
 done
 
+# ======
+# A local variable must hide a global variable that was looked up before in the
+# same or an earlier function scope, even if the variable lookup cache has it
+got=$("$SHELL" -c '
+	function g { x=g; y=$x; }
+	function h { x=h1; typeset x; x=h2; y=$x; }
+	function i { eval "typeset x"; x=i; }
+	x=0
+	for n in 1 2 3
+	do	g; h; i
+	done
+	echo $x $y
+' 2>&1)
+exp='h1 h2'
+[[ $got == "$exp" ]] || err_exit "local variable does not hide cached global variable" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+
+# ======
+# SHCOMP_CACHE caches compiled scripts, dot scripts and autoloaded functions
+mkdir -m 700 "$tmp/cache" "$tmp/cachefpath"
+print $'function cachelib\n{\n\tprint "lib $1"\n}' > "$tmp/cachelib"
+print $'function cachefn\n{\n\tprint "fn $1"\n}' > "$tmp/cachefpath/cachefn"
+print $'print "script $1"\nexit 3\nnot a (valid command' > "$tmp/cachescript"
+for i in 1 2
+do	got=$(export SHCOMP_CACHE=$tmp/cache FPATH=$tmp/cachefpath
+		. "$tmp/cachelib"; cachelib "$i"; cachefn "$i"
+		"$SHELL" "$tmp/cachescript" "$i"; print "status $?")
+	exp=$'lib '$i$'\nfn '$i$'\nscript '$i$'\nstatus 3'
+	[[ $got == "$exp" ]] || err_exit "SHCOMP_CACHE run $i" \
+		"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+done
+set -- "$tmp"/cache/*
+(( $# == 3 )) || err_exit "SHCOMP_CACHE should hold 3 files (got $*)"
+print $'function cachelib\n{\n\tprint "new lib $1"\n}' > "$tmp/cachelib"
+got=$(SHCOMP_CACHE=$tmp/cache; . "$tmp/cachelib"; cachelib 3)
+[[ $got == 'new lib 3' ]] || err_exit "changed dot script not read from source (got $(printf %q "$got"))"
+print $'print bad\nif' > "$tmp/cachelib"
+got=$(SHCOMP_CACHE=$tmp/cache; . "$tmp/cachelib" 2>/dev/null; print ok)
+[[ $got == ok ]] || err_exit "dot script with syntax error (got $(printf %q "$got"))"
+set -- "$tmp"/cache/!(*.shc)
+[[ -e $1 ]] && err_exit "syntax error leaves temporary files in SHCOMP_CACHE (got $*)"
+print greet > "$tmp/cachealias"
+print $'alias greet2="print $1"\ngreet2' > "$tmp/cachealias2"
+for a in one two
+do	got=$(SHCOMP_CACHE=$tmp/cache; alias greet="print $a"; . "$tmp/cachealias"; SHCOMP_CACHE=$tmp/cache "$SHELL" "$tmp/cachealias2" "$a")
+	[[ $got == "$a"$'\n'"$a" ]] || err_exit "SHCOMP_CACHE keeps expanded aliases" \
+		"(expected $(printf %q "$a"$'\n'"$a"), got $(printf %q "$got"))"
+done
+mkdir -m 775 "$tmp/cacheshared"
+chmod g+w "$tmp/cacheshared"
+got=$(SHCOMP_CACHE=$tmp/cacheshared; . "$tmp/cachelib" 2>/dev/null; print ok)
+set -- "$tmp"/cacheshared/*
+[[ -e $1 ]] && err_exit "SHCOMP_CACHE uses a group-writable directory (got $*)"
+
+# ======
+# Function bodies in compiled scripts are restored when first used
+cat > "$tmp/lazylib" <<-\EOF
+	function lazy_doc
+	{
+		cat <<-EOT
+		doc $1
+		EOT
+	}
+	function lazy_outer
+	{
+		function lazy_inner { print "inner $1"; }
+		lazy_inner "$@"
+	}
+	function .sh.math.lazy_sq x
+	{
+		.sh.value=$((x*x))
+	}
+	for i in 1 2
+	do	function lazy_loop { print "loop $i $1"; }
+	done
+	function lazy_arith { typeset -i i n=0; for ((i=0; i<$1; i++)); do ((n+=i)); done; print $n; }
+	function lazy_big
+	{
+		typeset s=
+EOF
+for ((i=0; i<5000; i++))
+do	print "s+=$i"
+done >> "$tmp/lazylib"
+print $'print ${#s}\n}' >> "$tmp/lazylib"
+"$SHELL" -c '. "$1"; typeset -f' x "$tmp/lazylib" > "$tmp/lazylib.out"
+${SHCOMP:-${SHELL%/*}/shcomp} "$tmp/lazylib" > "$tmp/lazylib.shc"
+for f in lazylib lazylib.shc
+do	got=$(. "$tmp/$f"; lazy_doc 1; lazy_doc 2; lazy_outer x; print $((lazy_sq(7))); lazy_big; lazy_loop y; lazy_arith 10; lazy_arith 5)
+	exp=$'doc 1\ndoc 2\ninner x\n49\n18890\nloop 2 y\n45\n10'
+	[[ $got == "$exp" ]] || err_exit "functions from $f" \
+		"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+done
+got=$("$SHELL" -c '. "$1"; typeset -f' x "$tmp/lazylib.shc")
+exp=$(<"$tmp/lazylib.out")
+[[ $got == "$exp" ]] || err_exit "typeset -f of uncalled compiled functions" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+
+# ======
+# Creating a local variable or reusing a pooled function scope must not leave
+# stale cached lookups of the same name in the caller or in a later call
+cat >$tmp/scopecache.sh <<\EOF2
+v=global a=global
+function show { print -r -- "show: x=$x v=$v"; }
+pf() { print -r -- "pf: x=$x v=$v"; }
+function outer { typeset v=outer; x=$v show; show; x=$v pf; pf; v=$v show; show; }
+outer; show; pf
+function f { print -rn -- "$a "; typeset a=local; print -r -- "$a"; }
+f; f; print $a
+function g { typeset -n r=a; print -r -- "$r"; typeset a=g; print -r -- "$r $a"; }
+g; g
+function h { typeset i; for i in 1 2; do typeset a=h$i; print -r -- "$a"; done; }
+h; print $a
+function k { print -r -- "$a"; }
+function m { typeset a=m; k; a=pre k; k; }
+m; m; k
+EOF2
+got=$("$SHELL" "$tmp/scopecache.sh" 2>&1)
+exp=$(cat <<\EOF2
+show: x=outer v=global
+show: x= v=global
+pf: x=outer v=outer
+pf: x=outer v=outer
+show: x=outer v=outer
+show: x=outer v=global
+show: x=outer v=global
+pf: x=outer v=global
+global local
+global local
+global
+global
+global g
+global
+global g
+h1
+h2
+global
+global
+pre
+global
+global
+pre
+global
+global
+EOF2
+)
+[[ $got == "$exp" ]] || err_exit "stale variable lookups across function scopes" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
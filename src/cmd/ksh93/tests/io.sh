@@ -1064,5 +1064,114 @@ let "$? <= 128" || err_exit "crash on huge RLIMIT_NOFILE"
 (ulimit -n 8; "$SHELL" --version) 2>/dev/null
 let "$? <= 128" || err_exit "crash on tiny RLIMIT_NOFILE"
 
+# ======
+# sfmove() may let the kernel copy file, pipe and socket data; the stream positions must stay right
+if	builtin cat 2>/dev/null
+then	integer i
+	for ((i=0; i<2000; i++))
+	do	print "line $i of the sfmove test file"
+	done > $tmp/mv.in
+	exp=$(<$tmp/mv.in)
+	{ print begin; cat $tmp/mv.in; print end; } > $tmp/mv.out
+	[[ $(<$tmp/mv.out) == $'begin\n'"$exp"$'\nend' ]] || err_exit 'cat file to file with buffered output around it'
+	cat $tmp/mv.in | cat > $tmp/mv.out
+	[[ $(<$tmp/mv.out) == "$exp" ]] || err_exit 'cat pipe to file'
+	cat $tmp/mv.in >> $tmp/mv.out
+	[[ $(<$tmp/mv.out) == "$exp"$'\n'"$exp" ]] || err_exit 'cat file appended to file'
+	got=$({ read line; read line; cat; } < $tmp/mv.in)
+	[[ $got == "${exp#*$'\n'*$'\n'}" ]] || err_exit 'cat of partially read file'
+	got=$(cat $tmp/mv.in | { read line; cat; })
+	[[ $got == "${exp#*$'\n'}" ]] || err_exit 'cat of partially read pipe'
+fi
+
+# ======
+# .sh.net socket options for /dev/tcp and /dev/udp redirections
+if	(exec 3<>/dev/udp/127.0.0.1/9) 2>/dev/null
+then	got=$(.sh.net=(timeout=2 nodelay=1 keepalive=1 sndbuf=65536 rcvbuf=65536)
+		exec 3<>/dev/udp/127.0.0.1/9 && print ok)
+	[[ $got == ok ]] || err_exit '/dev/udp redirection with .sh.net options fails'
+	got=$(.sh.net=(timeout=.5)
+		SECONDS=0
+		(exec 3<>/dev/tcp/127.0.0.1/9) 2>/dev/null
+		print $? $((SECONDS < 1.5)))
+	[[ $got == '1 1' ]] || err_exit 'refused /dev/tcp connection with .sh.net.timeout' \
+		"(expected '1 1', got $(printf %q "$got"))"
+fi
+
+# an address that is not routed (RFC 5737) usually drops the connection attempt,
+# which exercises the .sh.net.timeout deadline; skip if it fails at once instead
+got=$(.sh.net=(timeout=.5)
+	SECONDS=0
+	(exec 3<>/dev/tcp/192.0.2.1/9) 2>&1
+	print $? $SECONDS)
+if	[[ $got == *'timed out'* ]]
+then	[[ ${got##*$'\n'} == 1\ @(0.[4-9]|1.)* ]] || err_exit 'unanswered /dev/tcp connection with .sh.net.timeout' \
+		"(expected status 1 after about .5 seconds, got $(printf %q "$got"))"
+elif	[[ ${got##*$'\n'} == 1\ 0.[0-3]* ]]
+then	warning 'connecting to an unrouted address fails at once; skipping /dev/tcp timeout test'
+else	err_exit 'unanswered /dev/tcp connection with .sh.net.timeout' \
+		"(expected a timeout, got $(printf %q "$got"))"
+fi
+
+# ======
+# .sh.pipebuf sets the size of pipeline and co-process pipe buffers
+got=$(.sh.pipebuf=1Mi; head -c 3000000 /dev/zero | wc -c)
+(( got == 3000000 )) || err_exit "pipeline with .sh.pipebuf loses data (expected 3000000, got $got)"
+got=$(.sh.pipebuf=1Mi; yes "$(printf %0999d 0)" | head -n 3000 | { n=0; while IFS= read -r buf; do (( n += ${#buf} + 1 )); done; print $n; })
+(( got == 3000000 )) || err_exit "built-in reading pipe with .sh.pipebuf loses data (expected 3000000, got $got)"
+got=$(set -o posix; .sh.pipebuf=256Ki; head -c 3000000 /dev/zero | wc -c)
+(( got == 3000000 )) || err_exit "POSIX mode pipeline with .sh.pipebuf loses data (expected 3000000, got $got)"
+got=$(.sh.pipebuf=1Mi; cat |&
+	print -p hello; read -p line; exec 3>&p 3>&-; print -r -- "$line")
+[[ $got == hello ]] || err_exit "co-process with .sh.pipebuf fails (expected hello, got $(printf %q "$got"))"
+got=$(.sh.pipebuf=bogus; print ok | cat)
+[[ $got == ok ]] || err_exit "invalid .sh.pipebuf breaks pipelines"
+# the size belongs to the pipe it was set for, not to whatever is opened next
+mkfifo "$tmp/pipebuf.fifo"
+got=$(.sh.pipebuf=1Mi; cat |&
+	unset .sh.pipebuf
+	print -p "$(printf %02000d 0)"; read -r -p line; exec 3>&p 3>&-
+	{ print one; print two; } > "$tmp/pipebuf.fifo" &
+	read -r a < "$tmp/pipebuf.fifo"
+	print -r -- "$a ${#line}")
+[[ $got == 'one 2000' ]] || err_exit "pipe sized by .sh.pipebuf after it is unset" \
+	"(expected 'one 2000', got $(printf %q "$got"))"
+
+# ======
+# redirections of built-ins and functions are undone without leaking file descriptors
+function fn { print "fn$1"; print -u2 "err$1"; }
+got=$(for i in 1 2 3
+	do	print "out$i" >&2
+		fn "$i" 2>&1 >/dev/null
+		read x </dev/null
+	done 2>&1; print end)
+exp=$'out1\nerr1\nout2\nerr2\nout3\nerr3\nend'
+[[ $got == "$exp" ]] || err_exit "redirected built-ins and functions" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+if	[[ -d /proc/${.sh.pid}/fd ]]
+then	exp=$(cd /proc/${.sh.pid}/fd && set -- * && print $#)
+	for ((i=0; i<100; i++))
+	do	print hi >&2
+		fn "$i" >/dev/null 2>&1
+	done 2>/dev/null
+	got=$(cd /proc/${.sh.pid}/fd && set -- * && print $#)
+	(( got == exp )) || err_exit "redirected built-ins leak file descriptors (expected $exp, got $got)"
+fi
+unset -f fn
+
+# ======
+# many open file descriptors with streams
+got=$(
+	for ((i=0; i<500; i++))
+	do	exec {fd}<>/dev/null || break
+		read -u$fd x; print -u$fd x
+	done
+	print -n "$i "
+	(print sub) | cat
+	exec {fd}>&-
+	print -u$((fd-1)) x 2>/dev/null && print ok
+)
+[[ $got == $'500 sub\nok' ]] || err_exit "shell with many open descriptors (got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
@@ -560,6 +560,13 @@ if builtin cat 2> /dev/null; then
 	exp="a^Ib"
 	[[ $got == "$exp" ]] || err_exit "cat -T failed to convert tabs to ^I. (expected $(printf %q "$exp"), got $(printf %q "$got"))"
 
+	# --async  Read ahead in regular files; other input is copied as before.
+	got=$(cat --async "$tmp/sample_file" - "$tmp/file_with_tabs" < "$tmp/sample_file")
+	exp=$(cat "$tmp/sample_file" "$tmp/sample_file" "$tmp/file_with_tabs")
+	[[ $got == "$exp" ]] || err_exit "cat --async failed (expected $(printf %q "$exp"), got $(printf %q "$got"))"
+	got=$(print foo | cat --async - /dev/null)
+	[[ $got == foo ]] || err_exit "cat --async fails on a pipe (expected foo, got $(printf %q "$got"))"
+
 	got=$(cat this_file_does_not_exist 2>&1)
 	exp="this_file_does_not_exist: cannot open"
 	[[ $got =~ $exp ]] || err_exit "cat should give an error on non-existent files (expected $(printf %q "$exp"), got $(printf %q "$got"))"
@@ -601,6 +608,42 @@ if builtin tail 2> /dev/null; then
 		"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
 fi
 
+# tail -f should copy appended data, resume after truncation and follow a replaced log file
+if builtin tail 2> /dev/null; then
+	print one > "$tmp/follow"
+	: > "$tmp/follow.out"
+	tail -f -L -t 2 "$tmp/follow" > "$tmp/follow.out" 2> "$tmp/follow.err" &
+	pid=$!
+	function following
+	{
+		typeset i
+		for ((i = 0; i < 200; i++))
+		do	[[ $(<"$tmp/follow.out") == "$1" ]] && return 0
+			sleep .05
+		done
+		return 1
+	}
+	following one
+	print -n 'two\nthr' >> "$tmp/follow"
+	following $'one\ntwo'
+	print ee >> "$tmp/follow"
+	following $'one\ntwo\nthree'
+	print four > "$tmp/follow"
+	following $'one\ntwo\nthree\nfour'
+	mv "$tmp/follow" "$tmp/follow.1"
+	print five > "$tmp/follow"
+	following $'one\ntwo\nthree\nfour\nfive'
+	kill "$pid" 2>/dev/null
+	wait "$pid" 2>/dev/null
+	exp=$'one\ntwo\nthree\nfour\nfive'
+	got=$(<"$tmp/follow.out")
+	[[ $got == "$exp" ]] || err_exit "tail -f fails to follow appended, truncated or replaced file" \
+		"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+	got=$(<"$tmp/follow.err")
+	[[ $got == *'file truncated'*'log file change'* ]] || err_exit "tail -f fails to report truncated or replaced file" \
+		"(got $(printf %q "$got"))"
+fi
+
 # ======
 # Tests for the basename builtin
 if builtin basename 2> /dev/null; then
@@ -484,5 +484,25 @@ then	LANG=C.UTF-8
 		"(expected $(printf %q "$exp"); got $(printf %q "$got"))"
 fi
 
+# ======
+# Runs of ordinary characters are skipped in bulk; check multibyte text around them, across input buffer boundaries
+if	((SHOPT_MULTIBYTE))
+then	LANG=C.UTF-8
+	s='ascii text コーンシェル more text $ \ ` "'
+	for ((i=0; i<400; i++))
+	do	print -r -- "# $s"
+		print -r -- "x+='$s'"
+		print -r -- "y+=\"${s//[\$\\\`\"]/}\""
+	done > $tmp/mbskip.sh
+	print -r -- "cat <<'EOF'" >> $tmp/mbskip.sh
+	for ((i=0; i<400; i++))
+	do	print -r -- "$s"
+	done >> $tmp/mbskip.sh
+	print -r -- $'EOF\nprint -r -- "${#x} ${#y}"' >> $tmp/mbskip.sh
+	got=$(LC_ALL=C.UTF-8 "$SHELL" "$tmp/mbskip.sh")
+	exp=$(for ((i=0; i<400; i++)); do print -r -- "$s"; done)$'\n'"$((400*${#s})) $((400*(${#s}-4)))"
+	[[ $got == "$exp" ]] || err_exit 'multibyte characters mixed with ordinary text are not lexed correctly'
+fi
+
 # ======
 exit $((Errors<125?Errors:125))
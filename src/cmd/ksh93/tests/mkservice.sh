@@ -0,0 +1,142 @@
+########################################################################
+#                                                                      #
+#              This file is part of the ksh 93u+m package              #
+#             Copyright (c) 2026 Contributors to ksh 93u+m             #
+#                      and is licensed under the                       #
+#                 Eclipse Public License, Version 2.0                  #
+#                                                                      #
+#                A copy of the License is available at                 #
+#      https://www.eclipse.org/org/documents/epl-2.0/EPL-2.0.html      #
+#         (with md5 checksum 84283fa8859daf213bdda5a9f8d1be1d)         #
+#                                                                      #
+########################################################################
+
+. "${SHTESTS_COMMON:-${0%/*}/_common}"
+
+if((!SHOPT_MKSERVICE))
+then	warning 'shell compiled without SHOPT_MKSERVICE; skipping tests'
+	exit 0
+fi
+
+# ======
+# A loopback echo service. A connection that sends 'quit' is closed by its own
+# action function; one that sends 'bye' makes the action return non-zero so
+# the service closes it. Either way the close function must be called.
+cat > "$tmp/server.sh" <<\EOF
+log=$1 port=$2 host=${3:-localhost}
+mkservice serv "/dev/tcp/$host/$port" 2>/dev/null || exit 2
+function serv.accept
+{
+	print -r "accept" >> "$log"
+}
+function serv.action
+{
+	typeset line
+	read -r -u"$1" line || return 1
+	case $line in
+	quit)	print -r -u"$1" "gone"
+		typeset fd=$1
+		exec {fd}<&- ;;
+	bye)	return 1 ;;
+	*)	print -r -u"$1" "$line" ;;
+	esac
+	return 0
+}
+function serv.close
+{
+	print -r "close" >> "$log"
+}
+print -r "ready" >> "$log"
+eloop -t 1500
+print -r "done" >> "$log"
+EOF
+
+function client
+{
+	typeset fd r1 r2
+	exec {fd}<>"/dev/tcp/localhost/$port" || return
+	print -u$fd "hello $1"
+	read -r -u$fd r1
+	print -u$fd "$2"
+	read -r -u$fd r2
+	exec {fd}<&-
+	print -r "$r1/$r2" >> "$tmp/client.$1"
+}
+
+function startserver
+{
+	typeset try i
+	for ((try = 0; try < 5; try++))
+	do	port=$((20000 + RANDOM % 20000))
+		: > "$tmp/log"
+		"$SHELL" "$tmp/server.sh" "$tmp/log" "$port" "$@" &
+		server=$!
+		for ((i = 0; i < 100; i++))
+		do	[[ -s $tmp/log ]] && break
+			kill -0 "$server" 2>/dev/null || break
+			sleep .05
+		done
+		[[ -s $tmp/log ]] && return 0
+		wait "$server"
+	done
+	return 1
+}
+if	! startserver
+then	warning 'cannot start a mkservice server on a loopback port; skipping tests'
+	exit $((Errors<125?Errors:125))
+fi
+
+# more connections at once than the old fixed-size tables could hold
+integer nclients=40
+typeset -a clients
+for ((i = 0; i < nclients; i++))
+do	if ((i % 2))
+	then	client "$i" quit &
+	else	client "$i" bye &
+	fi
+	clients+=($!)
+done
+wait "${clients[@]}"
+wait "$server"
+
+integer naccept=0 nclose=0
+while read -r line
+do	case $line in
+	accept)	((naccept++)) ;;
+	close)	((nclose++)) ;;
+	esac
+done < "$tmp/log"
+((naccept == nclients)) || err_exit "accept function called $naccept times, expected $nclients"
+((nclose == nclients)) || err_exit "close function called $nclose times, expected $nclients" \
+	"(a connection closed by its action must still be reported)"
+[[ $(tail -n 1 "$tmp/log") == done ]] || err_exit "eloop -t did not return after the service went idle"
+
+for ((i = 0; i < nclients; i++))
+do	if ((i % 2))
+	then	exp="hello $i/gone"
+	else	exp="hello $i/"
+	fi
+	got=$(< "$tmp/client.$i")
+	[[ $got == "$exp" ]] || err_exit "connection $i" "(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+done
+
+# ======
+# Connecting with .sh.net.timeout set goes through the non-blocking connect code.
+# With a server on 127.0.0.1 only, connecting to localhost must still work if
+# localhost also resolves to an IPv6 address that refuses the connection.
+if	startserver 127.0.0.1
+then	got=$(.sh.net=(timeout=2)
+		SECONDS=0
+		exec {fd}<>"/dev/tcp/localhost/$port" || exit
+		print -u$fd "hello"
+		read -r -u$fd r1
+		print -u$fd bye
+		print -r "$r1 $((SECONDS < 2))")
+	wait "$server"
+	[[ $got == 'hello 1' ]] || err_exit "connection to localhost with .sh.net.timeout" \
+		"(expected 'hello 1', got $(printf %q "$got"))"
+else	warning 'cannot start a mkservice server on 127.0.0.1; skipping connect test'
+fi
+
+# ======
+exit $((Errors<125?Errors:125))
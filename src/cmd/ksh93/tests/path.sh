@@ -1049,5 +1049,38 @@ got=$?
 ((got==exp)) || err_exit "interactive shells exit after exec(1) fails to run a command (expected status '$exp', got status '$got' with output $(printf %q "$output"))"
 fi # !SHOPT_SCRIPTONLY
 
+# ======
+# SHPREFETCH only asks the system to read ahead; the files still run as usual
+print 'print one $1' > "$tmp/pf1"
+print 'print two' > "$tmp/pf2"
+cat > "$tmp/pfmain" <<-EOF
+	. $tmp/pf1 x; source $tmp/pf2
+	false &&
+	. $tmp/nonexistent
+	print skipped
+	cat <<\EOT
+	. $tmp/pf2
+	EOT
+EOF
+exp=$'one x\ntwo\nskipped\n. '"$tmp/pf2"
+for v in '' 1
+do	got=$(export SHPREFETCH=$v; "$SHELL" "$tmp/pfmain" 2>/dev/null; . "$tmp/pfmain" 2>/dev/null)
+	[[ $got == "$exp"$'\n'"$exp" ]] || err_exit "scripts with SHPREFETCH=$v" \
+		"(expected $(printf %q "$exp"$'\n'"$exp"), got $(printf %q "$got"))"
+done
+# a FIFO named in a . command must not be opened for the hint, which would
+# let a writer waiting for a reader go ahead
+if mkfifo "$tmp/pffifo" 2>/dev/null
+then	{ print x > "$tmp/pffifo"; } 2>/dev/null &
+	writer=$!
+	sleep .2
+	print "exit\n. $tmp/pffifo" > "$tmp/pfmain"
+	SHPREFETCH=1 "$SHELL" "$tmp/pfmain"
+	sleep .2
+	kill -0 "$writer" 2>/dev/null || err_exit "SHPREFETCH opens FIFOs"
+	kill "$writer" 2>/dev/null
+	wait "$writer" 2>/dev/null
+fi
+
 # ======
 exit $((Errors<125?Errors:125))
@@ -396,5 +396,22 @@ do	[[ $e == [0-9]* ]] && i=$e && continue
 	done
 done
 
+# ======
+# A word consisting only of "$name" or "${name}" is expanded without going through the macro expander;
+# the result must not be subject to further expansion and must honour the variable's attributes
+x='a\b * $y ~' y=
+set -- "$x" "${x}" "$y" "$unset_var" "$x"x
+exp=$'5\n<a\\b * $y ~>\n<a\\b * $y ~>\n<>\n<>\n<a\\b * $y ~x>'
+got=$(print -r -- "$#"; printf '<%s>\n' "$@")
+[[ $got == "$exp" ]] || err_exit '"$name" expansion' \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+typeset -L3 l=abcdef
+typeset -b b=dGhyZWU=
+typeset -i16 i=255
+got=$(printf '<%s>' "$l" "${b}" "$i")
+exp='<abc><dGhyZWU=><16#ff>'
+[[ $got == "$exp" ]] || err_exit '"$name" expansion with attributes' \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
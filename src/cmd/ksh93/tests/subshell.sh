@@ -1219,5 +1219,25 @@ got=$("$SHELL" -c 'x=$(fn(){ return 265; };echo ok|fn); echo exited $?' 2>&1)
 [[ e=$? -eq 0 && $got == "$exp" ]] || err_exit "regression involving SIGPIPE in subshell" \
 	"(expected status 0 and $(printf %q "$exp"), got status $e and $(printf %q "$got"))"
 
+# ======
+# Many distinct variables saved and restored by one virtual subshell
+# (the save list is hash-indexed; make sure growing and deleting from the index works)
+got=$("$SHELL" -c '
+	typeset -i i
+	for ((i=0; i<2000; i++)); do eval "v$i=p$i"; done
+	(
+		for ((i=0; i<2000; i++)); do eval "v$i=c$i"; done
+		for ((i=0; i<2000; i+=3)); do unset "v$i"; done
+		for ((i=0; i<2000; i+=7)); do eval "v$i=d$i"; done
+		for ((i=0; i<3000; i++)); do eval "w$i=x"; done
+		[[ $v1 == c1 && -z ${v3+s} && $v14 == d14 && $w2999 == x ]] || echo BAD_IN_SUBSHELL
+	)
+	for ((i=0; i<2000; i++)); do eval "[[ \$v$i == p$i ]]" || echo "BAD v$i"; done
+	[[ -z ${w0+s} ]] || echo BAD w0
+	echo done
+' 2>&1)
+[[ $got == done ]] || err_exit "variables not correctly restored after virtual subshell saved many" \
+	"(got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
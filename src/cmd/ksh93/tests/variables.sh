@@ -1756,5 +1756,19 @@ case ${.sh.version} in
 	;;
 esac
 
+# ======
+# lone "$name" and "${name}" words take the fast path only for set scalars
+got=$(
+	integer i=3
+	typeset -a arr=(1 2)
+	s='a  b*' e=
+	n=${.sh.stats.arg_simplevars}
+	set -- "$s" "${s}" "$i" "$arr" "$unset" "$e" "$s$s" "${s}x"
+	print -r -- $# "$1|$2|$3|$4|$5|$6|$7|$8" $((.sh.stats.arg_simplevars-n))
+)
+exp='8 a  b*|a  b*|3|1|||a  b*a  b*|a  b*x 3'
+[[ $got == "$exp" ]] || err_exit "simple variable argument words" \
+	"(expected $(printf %q "$exp"), got $(printf %q "$got"))"
+
 # ======
 exit $((Errors<125?Errors:125))
@@ -0,0 +1,143 @@
+/***********************************************************************
+*                                                                      *
+*              This file is part of the ksh 93u+m package              *
+*             Copyright (c) 2026 Contributors to ksh 93u+m             *
+*                      and is licensed under the                       *
+*                 Eclipse Public License, Version 2.0                  *
+*                                                                      *
+*                A copy of the License is available at                 *
+*      https://www.eclipse.org/org/documents/epl-2.0/EPL-2.0.html      *
+*         (with md5 checksum 84283fa8859daf213bdda5a9f8d1be1d)         *
+*                                                                      *
+***********************************************************************/
+#include	"sfdchdr.h"
+
+/*	Discipline to overlap file IO with processing.
+**	When reading, the kernel is asked to start fetching the next window
+**	of the file into the page cache while the current buffer is being
+**	consumed. When writing, writeback of each completed window is started
+**	right away instead of letting dirty pages pile up until close or sync.
+**	Pipes need none of this: the kernel already reads ahead and writes
+**	behind on their behalf, so this only applies to regular files.
+*/
+
+#if _lib_posix_fadvise && defined(POSIX_FADV_WILLNEED)
+#define ASYNC_READ	1
+#endif
+#if _lib_sync_file_range && defined(SYNC_FILE_RANGE_WRITE)
+#define ASYNC_WRITE	1
+#endif
+
+#define WINDOW		((Sfoff_t)1024*1024)	/* how far to work ahead	*/
+
+typedef struct _async_s
+{	Sfdisc_t	disc;	/* Sfio discipline			*/
+	Sfoff_t		ahead;	/* read-ahead requested up to here	*/
+	Sfoff_t		behind;	/* writeback started up to here		*/
+} Async_t;
+
+#if ASYNC_READ || ASYNC_WRITE
+
+static ssize_t asyncread(Sfio_t* f, void* buf, size_t n, Sfdisc_t* disc)
+{
+	Async_t*	as = (Async_t*)disc;
+	ssize_t		r;
+	Sfoff_t		here;
+
+	if((r = sfrd(f,buf,n,disc)) > 0)
+	{
+#if ASYNC_READ
+		/* keep at least half a window requested beyond what was read */
+		here = f->here + r;
+		if(here < as->ahead - WINDOW || here > as->ahead - WINDOW/2)
+		{	if(here > as->ahead)
+				as->ahead = here;
+			(void)posix_fadvise(f->file,(off_t)as->ahead,(off_t)WINDOW,POSIX_FADV_WILLNEED);
+			as->ahead += WINDOW;
+		}
+#else
+		NOT_USED(as);
+		NOT_USED(here);
+#endif
+	}
+	return r;
+}
+
+static ssize_t asyncwrite(Sfio_t* f, const void* buf, size_t n, Sfdisc_t* disc)
+{
+	Async_t*	as = (Async_t*)disc;
+	ssize_t		w;
+	Sfoff_t		here;
+
+	if((w = sfwr(f,buf,n,disc)) > 0)
+	{
+#if ASYNC_WRITE
+		/* start writing back every full window, without waiting for it */
+		here = f->here + w;
+		if(here < as->behind)
+			as->behind = here;
+		else if(here - as->behind >= WINDOW)
+		{	(void)sync_file_range(f->file,(off_t)as->behind,(off_t)(here - as->behind),SYNC_FILE_RANGE_WRITE);
+			as->behind = here;
+		}
+#else
+		NOT_USED(as);
+		NOT_USED(here);
+#endif
+	}
+	return w;
+}
+
+static int asyncexcept(Sfio_t* f, int type, void* data, Sfdisc_t* disc)
+{
+	NOT_USED(f);
+	NOT_USED(data);
+
+	if(type == SFIO_FINAL || type == SFIO_DPOP)
+		free(disc);
+	return 0;
+}
+
+#endif /* ASYNC_READ || ASYNC_WRITE */
+
+int sfdcasync(Sfio_t* f)
+{
+#if !ASYNC_READ && !ASYNC_WRITE
+	NOT_USED(f);
+	return -1;
+#else
+	Async_t*	as;
+	Sfdisc_t*	d;
+	Sfoff_t		here;
+	struct stat	st;
+
+	/* pushing it twice would only double the system calls */
+	for(d = f->disc; d; d = d->disc)
+		if(d->readf == asyncread)
+			return 0;
+	if(f->extent < 0 || (f->flags&SFIO_STRING))
+		return -1;
+	if(fstat(f->file,&st) < 0 || !S_ISREG(st.st_mode))
+		return -1;
+	if((here = sfseek(f,(Sfoff_t)0,SEEK_CUR)) < 0)
+		return -1;
+	if(!(as = (Async_t*)malloc(sizeof(Async_t))) )
+		return -1;
+
+	as->disc.readf = asyncread;
+	as->disc.writef = asyncwrite;
+	as->disc.seekf = NULL;
+	as->disc.exceptf = asyncexcept;
+	as->ahead = as->behind = here;
+
+	if(sfdisc(f,(Sfdisc_t*)as) != (Sfdisc_t*)as)
+	{	free(as);
+		return -1;
+	}
+#if ASYNC_READ && defined(POSIX_FADV_SEQUENTIAL)
+	if(f->flags&SFIO_READ)
+		(void)posix_fadvise(f->file,(off_t)0,(off_t)0,POSIX_FADV_SEQUENTIAL);
+#endif
+	return 0;
+#endif /* !ASYNC_READ && !ASYNC_WRITE */
+}
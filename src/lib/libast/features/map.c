@@ -60,6 +60,8 @@ main(void)
 	printf("#define regalloc	_ast_regalloc\n");
 	printf("#undef	regcache\n");
 	printf("#define regcache	_ast_regcache\n");
+	printf("#undef	regcachestat\n");
+	printf("#define regcachestat	_ast_regcachestat\n");
 	printf("#undef	regclass\n");
 	printf("#define regclass	_ast_regclass\n");
 	printf("#undef	regcmp\n");
@@ -181,6 +181,14 @@ typedef struct regstat_s
 	regflags_t	re_info;	/* REG_* info			*/
 } regstat_t;
 
+typedef struct regcachestat_s
+{
+	int		re_size;	/* regcache() capacity		*/
+	int		re_hits;	/* lookups found in the cache	*/
+	int		re_misses;	/* lookups that compiled	*/
+	int		re_evictions;	/* entries dropped for space	*/
+} regcachestat_t;
+
 struct regex_s
 {
 	size_t		re_nsub;	/* number of subexpressions	*/
@@ -199,7 +207,7 @@ extern void	regfree(regex_t*);
 
 /* nonstandard hooks */
 
-#define _REG_cache	1	/* have regcache()			*/
+#define _REG_cache	1	/* have regcache(), regcachestat()	*/
 #define _REG_class	1	/* have regclass()			*/
 #define _REG_collate	1	/* have regcollate(), regclass()	*/
 #define _REG_comb	1	/* have regcomb()			*/
@@ -227,6 +235,7 @@ extern int	regrexec(const regex_t*, const char*, size_t, size_t, regmatch_t*, re
 extern regstat_t* regstat(const regex_t*);
 
 extern regex_t*	regcache(const char*, regflags_t, int*);
+extern regcachestat_t* regcachestat(void);
 
 extern int	regsubcomp(regex_t*, const char*, const regflags_t*, int, regflags_t);
 extern int	regsubexec(const regex_t*, const char*, size_t, regmatch_t*);
@@ -25,18 +25,23 @@
 
 #include <ast.h>
 #include <regex.h>
-
 #define CACHE		8		/* default # cached re's	*/
 #define ROUND		64		/* pattern buffer size round	*/
 
-typedef unsigned long Key_t;
+/*
+ * entries are found through a hash table and kept on a circular
+ * list, most recently used first; a miss reuses the last entry
+ */
 
 typedef struct Cache_s
 {
+	struct Cache_s*	chain;		/* hash bucket chain		*/
+	struct Cache_s*	prev;		/* next more recently used	*/
+	struct Cache_s*	next;		/* next less recently used	*/
 	char*		pattern;
 	regex_t		re;
-	unsigned long	serial;
 	regflags_t	reflags;
+	unsigned int	hash;
 	int		keep;
 	int		size;
 } Cache_t;
@@ -44,9 +49,12 @@ typedef struct Cache_s
 typedef struct State_s
 {
 	unsigned int	size;
-	unsigned long	serial;
+	unsigned int	mask;
 	char*		locale;
-	Cache_t**	cache;
+	Cache_t*	cache;
+	Cache_t*	lru;
+	Cache_t**	hash;
+	regcachestat_t	stat;
 } State_t;
 
 static State_t	matchstate;
@@ -61,11 +69,40 @@ flushcache(void)
 	int		i;
 
 	for (i = matchstate.size; i--;)
-		if (matchstate.cache[i] && matchstate.cache[i]->keep)
+		if (matchstate.cache && matchstate.cache[i].keep)
 		{
-			matchstate.cache[i]->keep = 0;
-			regfree(&matchstate.cache[i]->re);
+			matchstate.cache[i].keep = 0;
+			regfree(&matchstate.cache[i].re);
 		}
+	if (matchstate.hash)
+		memset(matchstate.hash, 0, (matchstate.mask + 1) * sizeof(Cache_t*));
+}
+
+/*
+ * allocate the entries and hash table for matchstate.size re's
+ */
+
+static int
+initcache(void)
+{
+	unsigned int	i;
+
+	for (i = 1; i < matchstate.size; i <<= 1);
+	if (!(matchstate.cache = newof(0, Cache_t, matchstate.size, 0)) || !(matchstate.hash = newof(0, Cache_t*, i, 0)))
+	{
+		free(matchstate.cache);
+		matchstate.cache = 0;
+		return -1;
+	}
+	matchstate.mask = i - 1;
+	for (i = 0; i < matchstate.size; i++)
+	{
+		matchstate.cache[i].next = &matchstate.cache[(i + 1) % matchstate.size];
+		matchstate.cache[i].prev = &matchstate.cache[(i + matchstate.size - 1) % matchstate.size];
+	}
+	matchstate.lru = matchstate.cache;
+	matchstate.stat.re_size = matchstate.size;
+	return 0;
 }
 
 /*
@@ -76,30 +113,34 @@ regex_t*
 regcache(const char* pattern, regflags_t reflags, int* status)
 {
 	Cache_t*	cp;
+	Cache_t**	bp;
+	const char*	s;
+	unsigned int	h;
 	int		i;
-	char*		s;
-	int		empty;
-	int		unused;
-	int		old;
-	Key_t		key;
 
 	/*
-	 * 0 pattern flushes the cache and reflags>0 extends cache
+	 * 0 pattern flushes the cache and reflags>0 sets the cache size
 	 */
 
 	if (!pattern)
 	{
 		flushcache();
 		i = 0;
-		if (reflags > matchstate.size)
+		if (reflags > 0 && reflags != matchstate.size)
 		{
-			if (matchstate.cache = newof(matchstate.cache, Cache_t*, reflags, 0))
-				matchstate.size = reflags;
-			else
+			if (matchstate.cache)
 			{
-				matchstate.size = 0;
-				i = 1;
+				for (h = 0; h < matchstate.size; h++)
+					free(matchstate.cache[h].pattern);
+				free(matchstate.cache);
+				free(matchstate.hash);
+				matchstate.cache = 0;
+				matchstate.hash = 0;
 			}
+			matchstate.size = reflags;
+			i = initcache();
+			if (i)
+				matchstate.size = 0;
 		}
 		if (status)
 			*status = i;
@@ -107,9 +148,15 @@ regcache(const char* pattern, regflags_t reflags, int* status)
 	}
 	if (!matchstate.cache)
 	{
-		if (!(matchstate.cache = newof(0, Cache_t*, CACHE, 0)))
+		if (!matchstate.size)
+			matchstate.size = CACHE;
+		if (initcache())
+		{
+			matchstate.size = 0;
+			if (status)
+				*status = REG_ESPACE;
 			return NULL;
-		matchstate.size = CACHE;
+		}
 	}
 
 	/*
@@ -120,7 +167,7 @@ regcache(const char* pattern, regflags_t reflags, int* status)
 
 	if ((s = setlocale(LC_CTYPE, NULL)) != matchstate.locale)
 	{
-		matchstate.locale = s;
+		matchstate.locale = (char*)s;
 		flushcache();
 	}
 
@@ -128,38 +175,42 @@ regcache(const char* pattern, regflags_t reflags, int* status)
 	 * check if the pattern is in the cache
 	 */
 
-	for (i = 0; i < sizeof(key) && pattern[i]; i++)
-		((char*)&key)[i] = pattern[i];
-	for (; i < sizeof(key); i++)
-		((char*)&key)[i] = 0;
-	empty = unused = -1;
-	old = 0;
-	for (i = matchstate.size; i--;)
-		if (!matchstate.cache[i])
-			empty = i;
-		else if (!matchstate.cache[i]->keep)
-			unused = i;
-		else if (*(Key_t*)matchstate.cache[i]->pattern == key && !strcmp(matchstate.cache[i]->pattern, pattern) && matchstate.cache[i]->reflags == reflags)
+	for (h = reflags, s = pattern; *s; s++)
+		h = h * 31 + *(unsigned char*)s;
+	bp = &matchstate.hash[h & matchstate.mask];
+	for (cp = *bp; cp; cp = cp->chain)
+		if (cp->hash == h && cp->reflags == reflags && !strcmp(cp->pattern, pattern))
 			break;
-		else if (!matchstate.cache[old] || matchstate.cache[old]->serial > matchstate.cache[i]->serial)
-			old = i;
-	if (i < 0)
+	if (cp)
 	{
-		if (unused < 0)
+		matchstate.stat.re_hits++;
+		if (cp != matchstate.lru)
 		{
-			if (empty < 0)
-				unused = old;
-			else
-				unused = empty;
-		}
-		if (!(cp = matchstate.cache[unused]) && !(cp = matchstate.cache[unused] = newof(0, Cache_t, 1, 0)))
-		{
-			if (status)
-				*status = REG_ESPACE;
-			return NULL;
+			cp->prev->next = cp->next;
+			cp->next->prev = cp->prev;
+			cp->next = matchstate.lru;
+			cp->prev = matchstate.lru->prev;
+			cp->prev->next = cp;
+			cp->next->prev = cp;
+			matchstate.lru = cp;
 		}
+	}
+	else
+	{
+		/*
+		 * the least recently used entry is last on the
+		 * circular list, so making it the head moves it first
+		 */
+
+		matchstate.stat.re_misses++;
+		cp = matchstate.lru = matchstate.lru->prev;
 		if (cp->keep)
 		{
+			Cache_t**	pp;
+
+			matchstate.stat.re_evictions++;
+			for (pp = &matchstate.hash[cp->hash & matchstate.mask]; *pp != cp; pp = &(*pp)->chain);
+			*pp = cp->chain;
 			cp->keep = 0;
 			regfree(&cp->re);
 		}
@@ -168,28 +219,38 @@ regcache(const char* pattern, regflags_t reflags, int* status)
 			cp->size = roundof(i, ROUND);
 			if (!(cp->pattern = newof(cp->pattern, char, cp->size, 0)))
 			{
+				cp->size = 0;
+				matchstate.lru = cp->next;
 				if (status)
 					*status = REG_ESPACE;
 				return NULL;
 			}
 		}
 		strcpy(cp->pattern, pattern);
-		while (++i < sizeof(Key_t))
-			cp->pattern[i] = 0;
-		pattern = (const char*)cp->pattern;
-		if (i = regcomp(&cp->re, pattern, reflags))
+		if (i = regcomp(&cp->re, cp->pattern, reflags))
 		{
+			matchstate.lru = cp->next;
 			if (status)
 				*status = i;
 			return NULL;
 		}
 		cp->keep = 1;
 		cp->reflags = reflags;
+		cp->hash = h;
+		cp->chain = *bp;
+		*bp = cp;
 	}
-	else
-		cp = matchstate.cache[i];
-	cp->serial = ++matchstate.serial;
 	if (status)
 		*status = 0;
 	return &cp->re;
 }
+
+/*
+ * return the regcache() statistics
+ */
+
+regcachestat_t*
+regcachestat(void)
+{
+	return &matchstate.stat;
+}
@@ -71,7 +71,8 @@ int sfclose(Sfio_t* f)
 		if(f->pool == &_Sfpool)
 		{	int	n;
 
-			for(n = 0; n < _Sfpool.n_sf; ++n)
+			/* search from the end: recent streams tend to be closed first */
+			for(n = _Sfpool.n_sf; --n >= 0; )
 			{	if(_Sfpool.sf[n] != f)
 					continue;
 				/* found it */
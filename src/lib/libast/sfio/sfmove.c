@@ -28,6 +28,124 @@
 */
 #define MAX_SSIZE	((ssize_t)((~((size_t)0)) >> 1))
 
+#if _lib_copy_file_range || _lib_splice || (_lib_sendfile && _sys_sendfile)
+#define _sfmv_kernel	1
+#if _sys_sendfile
+#include	<sys/sendfile.h>
+#endif
+
+#define MV_CHUNK	((size_t)1 << 30)	/* max bytes per system call	*/
+#define MV_COPY		1	/* copy_file_range(): file to file	*/
+#define MV_SPLICE	2	/* splice(): either side is a pipe	*/
+#define MV_SEND		3	/* sendfile(): file to anything		*/
+
+/*	See if the kernel can move data to or from f on our behalf:
+**	it must be a plain file descriptor with no discipline that can
+**	see or alter the data, and nothing pending in its buffer.
+*/
+static int mvplain(Sfio_t* f, int rw)
+{
+	Sfdisc_t*	disc;
+
+	if(f->file < 0 || f->push || SFISNULL(f) ||
+	   (f->flags&(SFIO_STRING|SFIO_WHOLE|SFIO_APPENDWR)) || (f->bits&SFIO_HOLE) )
+		return 0;
+	for(disc = f->disc; disc; disc = disc->disc)
+		if(disc->readf || disc->writef || disc->seekf)
+			return 0;
+	if(rw == SFIO_READ)
+		return f->next >= f->endb && !(f->rsrv && f->rsrv->slen < 0);
+	return f->next <= f->data;
+}
+
+/*	Put the file offset of a seekable stream where sfio thinks it is.
+*/
+static int mvsync(Sfio_t* f)
+{
+	if(f->extent < 0)
+		return 0;
+	if(f->flags&SFIO_PUBLIC)
+		return (f->here = lseek(f->file,(off_t)0,SEEK_CUR)) < 0 ? -1 : 0;
+	return lseek(f->file,(off_t)f->here,SEEK_SET) != f->here ? -1 : 0;
+}
+
+/*	Move up to n bytes (n < 0: all) from fr to fw without copying them
+**	through user space. Returns the number of bytes moved; 0 means the
+**	caller should do it the ordinary way, which also takes care of EOF
+**	and of reporting any error.
+*/
+static Sfoff_t mvkernel(Sfio_t* fr, Sfio_t* fw, Sfoff_t n)
+{
+	struct stat	rst, wst;
+	Sfoff_t		moved = 0;
+	ssize_t		r;
+	size_t		w;
+	int		how, oerrno = errno;
+
+	if(fstat(fr->file,&rst) < 0 || fstat(fw->file,&wst) < 0)
+		goto done;
+	if(S_ISFIFO(rst.st_mode) || S_ISFIFO(wst.st_mode))
+		how = MV_SPLICE;
+	else if(!S_ISREG(rst.st_mode))
+		goto done;
+	else if(S_ISREG(wst.st_mode))
+		how = MV_COPY;
+	else	how = MV_SEND;
+	if(mvsync(fr) < 0 || mvsync(fw) < 0)
+		goto done;
+
+	while(n != 0)
+	{	w = (n < 0 || n > (Sfoff_t)MV_CHUNK) ? MV_CHUNK : (size_t)n;
+		switch(how)
+		{
+#if _lib_copy_file_range
+		case MV_COPY:
+			r = copy_file_range(fr->file,NULL,fw->file,NULL,w,0);
+			break;
+#endif
+#if _lib_splice
+		case MV_SPLICE:
+			r = splice(fr->file,NULL,fw->file,NULL,w,SPLICE_F_MOVE|SPLICE_F_MORE);
+			break;
+#endif
+#if _lib_sendfile && _sys_sendfile
+		case MV_SEND:
+			r = sendfile(fw->file,fr->file,NULL,w);
+			break;
+#endif
+		default:
+			r = -1;
+			errno = ENOSYS;
+			break;
+		}
+		if(r <= 0)
+		{	/* copy_file_range() cannot cross some file systems */
+			if(r < 0 && moved == 0 && how == MV_COPY)
+			{	how = MV_SEND;
+				continue;
+			}
+			break;
+		}
+		moved += r;
+		if(n > 0)
+			n -= r;
+	}
+
+	if(moved > 0)
+	{	fr->here += moved;
+		if(fr->extent >= 0 && fr->here > fr->extent)
+			fr->extent = fr->here;
+		fw->here += moved;
+		if(fw->extent >= 0 && fw->here > fw->extent)
+			fw->extent = fw->here;
+	}
+done:
+	/* errors are left for the ordinary code path to detect and report */
+	errno = oerrno;
+	return moved;
+}
+#endif /*_lib_copy_file_range || _lib_splice || _lib_sendfile*/
+
 Sfoff_t sfmove(Sfio_t*	fr,	/* moving data from this stream */
 	       Sfio_t*	fw,	/* moving data to this stream */
 	       Sfoff_t	n,	/* number of bytes/records to move. <0 for unbounded move */
@@ -40,6 +158,9 @@ Sfoff_t sfmove(Sfio_t*	fr,	/* moving data from this stream */
 	Sfoff_t		n_move, sk, cur;
 	uchar		*rbuf = NULL;
 	ssize_t		rsize = 0;
+#if _sfmv_kernel
+	int		kernel = 1;
+#endif
 
 	if(!(fr)) return 0;
 
@@ -94,6 +215,21 @@ Sfoff_t sfmove(Sfio_t*	fr,	/* moving data from this stream */
 			/* else: stream unstacking may happen below */
 		}
 
+#if _sfmv_kernel
+		/* let the kernel move the data if neither stream needs to see it */
+		if(kernel && fw)
+		{	kernel = 0;
+			if(mvplain(fr,SFIO_READ) && (fw->next <= fw->data || SFFLSBUF(fw,-1) >= 0) &&
+			   mvplain(fw,SFIO_WRITE) && (sk = mvkernel(fr,fw,n)) > 0)
+			{	n_move += sk;
+				if(n > 0)
+					n -= sk;
+				kernel = 1;
+				goto again;
+			}
+		}
+#endif
+
 		/* about to move all, set map to a large amount */
 		if(n < 0 && (fr->bits&SFIO_MMAP) && !(fr->bits&SFIO_MVSIZE) )
 		{	SFMVSET(fr);
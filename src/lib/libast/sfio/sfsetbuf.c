@@ -195,7 +195,10 @@ void* sfsetbuf(Sfio_t*	f,	/* stream to be buffered */
 		if(disc->seekf)
 			break;
 
-	if((init || local) && !(f->flags&SFIO_STRING))
+	/* at exit, _sfcleanup() only unbuffers synced write streams; there is
+	** no need to stat every one of them again
+	*/
+	if((init || (local && !(_Sfexiting && size == 0))) && !(f->flags&SFIO_STRING))
 	{	/* ASSERT(f->file >= 0) */
 		st.st_mode = 0;
 
@@ -385,7 +388,10 @@ setbuf:
 
 	f->flags = (f->flags & ~SFIO_MALLOC)|sf_malloc;
 
-	if(obuf && obuf != f->data && osize > 0 && (oflags&SFIO_MALLOC))
+	/* no point freeing buffers at exit: in a forked child that only
+	** touches (and copies) heap pages shared with the parent
+	*/
+	if(obuf && obuf != f->data && osize > 0 && (oflags&SFIO_MALLOC) && !_Sfexiting)
 	{	free(obuf);
 		obuf = NULL;
 	}
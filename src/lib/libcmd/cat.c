@@ -26,9 +26,10 @@
 
 #include <cmd.h>
 #include <fcntl.h>
+#include <sfdisc.h>
 
 static const char usage[] =
-"[-?\n@(#)$Id: cat (ksh 93u+m) 2022-08-30 $\n]"
+"[-?\n@(#)$Id: cat (ksh 93u+m) 2026-10-19 $\n]"
 "[--catalog?" ERROR_CATALOG "]"
 "[+NAME?cat - concatenate files]"
 "[+DESCRIPTION?\bcat\b copies each \afile\a in sequence to the standard"
@@ -62,6 +63,9 @@ static const char usage[] =
 "[R:regress?Regression test defaults: \b-v\b buffer size 4.]"
 "[S:silent?\bcat\b is silent about non-existent files.]"
 "[T:show-blank|show-tabs?Causes tabs to be copied as \b^I\b.]"
+"[01:async?Ask the system to read ahead in each \afile\a operand that is a"
+"	regular file while the previous part is being copied. Standard input"
+"	is left alone.]"
 
 "\n"
 "\n[file ...]\n"
@@ -400,6 +404,7 @@ b_cat(int argc, char** argv, Shbltin_t* context)
 	Reserve_f	reserve = sfreserve;
 	int		att;
 	int		dovcat = 0;
+	int		async = 0;
 	char		states[UCHAR_MAX+1];
 
 	cmdinit(argc, argv, context, ERROR_CATALOG, 0);
@@ -437,6 +442,9 @@ b_cat(int argc, char** argv, Shbltin_t* context)
 		case 'R':
 			reserve = opt_info.num ? regress : sfreserve;
 			continue;
+		case -1:
+			async = opt_info.num;
+			continue;
 		case 's':
 			n = att ? F_FLAG : S_FLAG;
 			break;
@@ -529,6 +537,8 @@ b_cat(int argc, char** argv, Shbltin_t* context)
 			error_info.errors = 1;
 			continue;
 		}
+		else if (async)
+			sfdcasync(fp);
 		if (flags&U_FLAG)
 			sfsetbuf(fp, fp, -1);
 		if (dovcat)
@@ -26,7 +26,7 @@
  */
 
 static const char usage[] =
-"+[-?\n@(#)$Id: tail (ksh 93u+m) 2024-07-31 $\n]"
+"+[-?\n@(#)$Id: tail (ksh 93u+m) 2026-10-19 $\n]"
 "[--catalog?" ERROR_CATALOG "]"
 "[+NAME?tail - output trailing portion of one or more files ]"
 "[+DESCRIPTION?\btail\b copies one or more input files to standard output "
@@ -61,13 +61,17 @@ static const char usage[] =
 	"for \achars\a indicates an offset from the end of the file.]"
 "[f:forever|follow?Loop forever trying to read more characters as the "
 	"end of each file to copy new data. Ignored if reading from a pipe "
-	"or fifo.]"
+	"or fifo. If a file is truncated, copying starts over at its beginning. "
+	"Where the system supports it, files are watched for changes and "
+	"new data is copied as soon as it is written; otherwise, and for "
+	"files that cannot be watched, each file is checked once a second.]"
 "[h!:headers?Output filename headers.]"
 "[l:lines?Copy units of lines. This is the default.]"
 "[L:log?When a \b--forever\b file times out via \b--timeout\b, verify that "
 	"the current file has not been renamed and replaced by another file "
 	"of the same name (a common log file practice) before giving up on "
-	"the file.]"
+	"the file. If files are watched for changes, this is also checked "
+	"as soon as a file is renamed and all its data has been copied.]"
 "[q:quiet?Don't output filename headers. For GNU compatibility.]"
 "[r:reverse?Output lines in reverse order.]"
 "[s:silent?Don't warn about timeout expiration and log file changes.]"
@@ -107,6 +111,16 @@ static const char usage[] =
 #include <rev.h>
 #include <time.h>
 
+#include "FEATURE/tail"
+
+#if _sys_inotify && _lib_inotify_init1 && _lib_inotify_add_watch && _lib_inotify_rm_watch && _hdr_poll
+#define _tail_inotify	1
+#include <sys/inotify.h>
+#include <poll.h>
+#define WATCH		(IN_MODIFY|IN_ATTRIB|IN_MOVE_SELF|IN_DELETE_SELF)
+#define ROTATE		(IN_MOVE_SELF|IN_DELETE_SELF)
+#endif
+
 #define COUNT		(1<<0)
 #define ERROR		(1<<1)
 #define FOLLOW		(1<<2)
@@ -143,8 +157,169 @@ struct Tail_s
 	long		dev;
 	long		ino;
 	int		fifo;
+	int		wd;		/* inotify watch or -1 */
+	int		dwd;		/* inotify directory watch or -1 */
+	int		events;		/* inotify events since last check */
 };
 
+#if _tail_inotify
+
+typedef struct Notify_s
+{
+	int		fd;
+	int		size;
+	Tail_t**	wd;		/* files indexed by watch */
+	int*		dirs;		/* directory watch reference counts */
+} Notify_t;
+
+/*
+ * make room for watch wd
+ */
+
+static void
+grow(Notify_t* np, int wd)
+{
+	int	n;
+
+	if (wd >= np->size)
+	{
+		n = np->size;
+		np->size = roundof(wd + 1, 64);
+		if (!(np->wd = newof(np->wd, Tail_t*, np->size, 0)) || !(np->dirs = newof(np->dirs, int, np->size, 0)))
+		{
+			error(ERROR_SYSTEM|ERROR_PANIC, "out of memory");
+			UNREACHABLE();
+		}
+		memset(np->wd + n, 0, (np->size - n) * sizeof(Tail_t*));
+		memset(np->dirs + n, 0, (np->size - n) * sizeof(int));
+	}
+}
+
+/*
+ * stop watching tp
+ */
+
+static void
+unwatch(Notify_t* np, Tail_t* tp)
+{
+	if (tp->wd >= 0)
+	{
+		inotify_rm_watch(np->fd, tp->wd);
+		np->wd[tp->wd] = 0;
+		tp->wd = -1;
+	}
+	if (tp->dwd >= 0)
+	{
+		if (np->dirs[tp->dwd] && !--np->dirs[tp->dwd])
+			inotify_rm_watch(np->fd, tp->dwd);
+		tp->dwd = -1;
+	}
+	tp->events = 0;
+}
+
+/*
+ * (re)watch tp->name for changes; files that cannot be
+ * watched are checked with fstat() on every wakeup
+ */
+
+static void
+watch(Notify_t* np, Tail_t* tp)
+{
+	int	wd;
+
+	unwatch(np, tp);
+	if (tp->fifo || tp->sp == sfstdin || (wd = inotify_add_watch(np->fd, tp->name, WATCH)) < 0)
+		return;
+	grow(np, wd);
+	np->wd[wd] = tp;
+	tp->wd = wd;
+	/* look at least once, in case it changed before the watch was added */
+	tp->events = IN_MODIFY;
+}
+
+/*
+ * wake up when a file appears in the directory of a renamed log file;
+ * files in the same directory share one watch, removed by unwatch()
+ */
+
+static void
+watchdir(Notify_t* np, Tail_t* tp)
+{
+	char*	s;
+	size_t	n;
+	int	wd;
+	char	dir[PATH_MAX];
+
+	if (tp->dwd >= 0)
+		return;
+	if (!(s = strrchr(tp->name, '/')))
+		wd = inotify_add_watch(np->fd, ".", IN_CREATE|IN_MOVED_TO);
+	else if ((n = s - tp->name) < sizeof(dir))
+	{
+		if (!n)
+			n = 1;
+		memcpy(dir, tp->name, n);
+		dir[n] = 0;
+		wd = inotify_add_watch(np->fd, dir, IN_CREATE|IN_MOVED_TO);
+	}
+	else
+		return;
+	if (wd < 0)
+		return;
+	grow(np, wd);
+	np->dirs[wd]++;
+	tp->dwd = wd;
+}
+
+/*
+ * wait up to tv for a watched file to change and note its events
+ * return nonzero if interrupted
+ */
+
+static int
+notify(Notify_t* np, Tv_t* tv)
+{
+	struct inotify_event*	ev;
+	struct pollfd		pfd;
+	char*			s;
+	char*			e;
+	ssize_t			z;
+	union
+	{
+		struct inotify_event	ev;
+		char			buf[4096];
+	}			u;
+
+	pfd.fd = np->fd;
+	pfd.events = POLLIN;
+	switch (poll(&pfd, 1, tv->tv_sec * 1000 + tv->tv_nsec / 1000000))
+	{
+	case -1:
+		return errno == EINTR;
+	case 0:
+		return 0;
+	}
+	while ((z = read(np->fd, u.buf, sizeof(u.buf))) > 0)
+		for (s = u.buf, e = s + z; s < e; s += sizeof(struct inotify_event) + ev->len)
+		{
+			ev = (struct inotify_event*)s;
+			if (ev->wd >= 0 && ev->wd < np->size && np->wd[ev->wd])
+			{
+				np->wd[ev->wd]->events |= ev->mask;
+				if (ev->mask & IN_IGNORED)
+				{
+					np->wd[ev->wd]->wd = -1;
+					np->wd[ev->wd] = 0;
+				}
+			}
+			else if (ev->wd >= 0 && ev->wd < np->size && (ev->mask & IN_IGNORED))
+				np->dirs[ev->wd] = 0;
+		}
+	return 0;
+}
+
+#endif
+
 static const char	header_fmt[] = "\n==> %s <==\n";
 
 /*
@@ -444,6 +619,10 @@ b_tail(int argc, char** argv, Shbltin_t* context)
 	Tail_t*		hp;
 	Tail_t*		files;
 	Tv_t		tv;
+#if _tail_inotify
+	Notify_t	notify_data;
+	Notify_t*	np = 0;
+#endif
 
 	cmdinit(argc, argv, context, ERROR_CATALOG, ERROR_NOTIFY);
 	for (;;)
@@ -665,10 +844,37 @@ b_tail(int argc, char** argv, Shbltin_t* context)
 		n = 1;
 		tv.tv_sec = 1;
 		tv.tv_nsec = 0;
+#if _tail_inotify
+		if ((notify_data.fd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC)) >= 0)
+		{
+			np = &notify_data;
+			np->size = 0;
+			np->wd = 0;
+			np->dirs = 0;
+		}
+#endif
+		for (fp = files; fp; fp = fp->next)
+		{
+			fp->wd = fp->dwd = -1;
+#if _tail_inotify
+			if (np)
+				watch(np, fp);
+#endif
+		}
 		while (fp = files)
 		{
 			if (n)
 				n = 0;
+#if _tail_inotify
+			else if (np)
+			{
+				if (sh_checksig(context) || notify(np, &tv) && sh_checksig(context))
+				{
+					error_info.errors++;
+					break;
+				}
+			}
+#endif
 			else if (sh_checksig(context) || tvsleep(&tv, NULL) && sh_checksig(context))
 			{
 				error_info.errors++;
@@ -677,11 +883,23 @@ b_tail(int argc, char** argv, Shbltin_t* context)
 			pp = 0;
 			while (fp)
 			{
-				if (fstat(sffileno(fp->sp), &st))
+				if (fp->wd >= 0 && !fp->events)
+					st.st_size = fp->end;
+				else if (fstat(sffileno(fp->sp), &st))
+				{
 					error(ERROR_system(0), "%s: cannot stat", fp->name);
-				else if (fp->fifo || fp->end < st.st_size)
+					goto drop;
+				}
+				if (!fp->fifo && st.st_size < fp->end)
+				{
+					if (!(flags & SILENT))
+						error(ERROR_warn(0), "%s: file truncated", fp->name);
+					sfpurge(fp->sp);
+					sfseek(fp->sp, 0, SEEK_SET);
+					fp->cur = fp->end = 0;
+				}
+				if (fp->fifo || fp->end < st.st_size)
 				{
-					n = 1;
 					if (timeout)
 						fp->expire = NOW + timeout;
 					z = fp->fifo ? SFIO_UNBOUND : st.st_size - fp->cur;
@@ -705,10 +923,35 @@ b_tail(int argc, char** argv, Shbltin_t* context)
 							w = 0;
 						sfread(fp->sp, s, w);
 						fp->end += w;
+						/* look again at once unless only a partial line is waiting */
+						if (w)
+							n = 1;
 					}
 					goto next;
 				}
-				else if (!timeout || fp->expire > NOW)
+#if _tail_inotify
+				if (fp->events)
+				{
+					if ((flags & LOG) && (fp->events & ROTATE) && !stat(fp->name, &st) && (fp->dev != st.st_dev || fp->ino != st.st_ino) && !init(fp, 0, 0, flags, &format))
+					{
+						if (!(flags & SILENT))
+							error(ERROR_warn(0), "%s: log file change", fp->name);
+						fp->expire = NOW + timeout;
+						watch(np, fp);
+						n = 1;
+						goto next;
+					}
+					/* keep checking a renamed log file until it is replaced or times out */
+					if ((flags & LOG) && (fp->events & ROTATE))
+					{
+						fp->events &= ROTATE;
+						watchdir(np, fp);
+					}
+					else
+						fp->events = 0;
+				}
+#endif
+				if (!timeout || fp->expire > NOW)
 					goto next;
 				else
 				{
@@ -728,12 +971,21 @@ b_tail(int argc, char** argv, Shbltin_t* context)
 							if (!(flags & SILENT))
 								error(ERROR_warn(0), "%s: log file change", fp->name);
 							fp->expire = NOW + timeout;
+#if _tail_inotify
+							if (np)
+								watch(np, fp);
+#endif
 							goto next;
 						}
 					}
 					if (!(flags & SILENT))
 						error(ERROR_warn(0), "%s: %s timeout", fp->name, fmtelapsed(timeout, 1));
 				}
+			drop:
+#if _tail_inotify
+				if (np)
+					unwatch(np, fp);
+#endif
 				if (fp->sp && fp->sp != sfstdin)
 					sfclose(fp->sp);
 				if (pp)
@@ -748,11 +1000,23 @@ b_tail(int argc, char** argv, Shbltin_t* context)
 			}
 			if (sfsync(sfstdout))
 			{
+#if _tail_inotify
+				if (np)
+					close(np->fd);
+#endif
 				error(ERROR_system(1), "write error");
 				UNREACHABLE();
 			}
 		}
 	done:
+#if _tail_inotify
+		if (np)
+		{
+			close(np->fd);
+			free(np->wd);
+			free(np->dirs);
+		}
+#endif
 		for (fp = files; fp; fp = fp->next)
 			if (fp->sp && fp->sp != sfstdin)
 				sfclose(fp->sp);